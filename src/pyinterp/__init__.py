@@ -5,11 +5,13 @@
 from . import version
 from .axis import TemporalAxis
 from .binning import Binning2D
-from .core import Axis
+from .core import Axis, BicubicCache
 from .grid import Grid2D, Grid3D, Grid4D
 from .rtree import RTree
-from .interpolator.bicubic import bicubic
-from .interpolator.bivariate import bivariate
+from .interpolator.bicubic import bicubic, bicubic_gradient
+from .interpolator.bivariate import bivariate, bilinear_gradient
+from .interpolator.plan import BivariatePlan, TrivariatePlan
+from .interpolator.stream import TrivariateStream
 from .interpolator.trivariate import trivariate
 from .interpolator.quadrivariate import quadrivariate
 __version__ = version.release()
@@ -283,6 +283,13 @@ class Grid3DFloat64:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
 
 class Grid3DFloat32:
     array: numpy.ndarray[numpy.float32]
@@ -300,6 +307,13 @@ class Grid3DFloat32:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
 
 class Grid4DFloat64:
     array: numpy.ndarray[numpy.float64]
@@ -318,6 +332,13 @@ class Grid4DFloat64:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
 
 class Grid4DFloat32:
     array: numpy.ndarray[numpy.float32]
@@ -336,6 +357,13 @@ class Grid4DFloat32:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
 
 class TemporalGrid3DFloat64:
     array: numpy.ndarray[numpy.float64]
@@ -353,6 +381,13 @@ class TemporalGrid3DFloat64:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
 
 class TemporalGrid3DFloat32:
     array: numpy.ndarray[numpy.float32]
@@ -370,6 +405,13 @@ class TemporalGrid3DFloat32:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
 
 class TemporalGrid4DFloat64:
     array: numpy.ndarray[numpy.float64]
@@ -388,6 +430,13 @@ class TemporalGrid4DFloat64:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
 
 class TemporalGrid4DFloat32:
     array: numpy.ndarray[numpy.float32]
@@ -406,6 +455,137 @@ class TemporalGrid4DFloat32:
     def __setstate__(self, state: tuple) -> None:
         ...
 
+    def update_array(self, array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def update_slice(self, index: int,
+                     values: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+
+class MultiGrid2DFloat64:
+    array: numpy.ndarray[numpy.float64]
+    variables: int
+    x: Axis
+    y: Axis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self, x: Axis, y: Axis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+
+class MultiGrid2DFloat32:
+    array: numpy.ndarray[numpy.float32]
+    variables: int
+    x: Axis
+    y: Axis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self, x: Axis, y: Axis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+
+class MultiGrid3DFloat64:
+    array: numpy.ndarray[numpy.float64]
+    variables: int
+    x: Axis
+    y: Axis
+    z: Axis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self, x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+
+class MultiGrid3DFloat32:
+    array: numpy.ndarray[numpy.float32]
+    variables: int
+    x: Axis
+    y: Axis
+    z: Axis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self, x: Axis, y: Axis, z: Axis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+
+class TemporalMultiGrid3DFloat64:
+    array: numpy.ndarray[numpy.float64]
+    variables: int
+    x: Axis
+    y: Axis
+    z: TemporalAxis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self, x: Axis, y: Axis, z: TemporalAxis,
+                 array: numpy.ndarray[numpy.float64]) -> None:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+
+class TemporalMultiGrid3DFloat32:
+    array: numpy.ndarray[numpy.float32]
+    variables: int
+    x: Axis
+    y: Axis
+    z: TemporalAxis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self, x: Axis, y: Axis, z: TemporalAxis,
+                 array: numpy.ndarray[numpy.float32]) -> None:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+
+class SharedMemory:
+    name: str
+    ref_count: int
+    size: int
+
+    @staticmethod
+    def attach(name: str) -> 'SharedMemory':
+        ...
+
+    @staticmethod
+    def create(name: str, size: int) -> 'SharedMemory':
+        ...
+
+    @staticmethod
+    def unlink(name: str) -> bool:
+        ...
+
 
 class RadialBasisFunction:
     Cubic: 'RadialBasisFunction'
@@ -439,7 +619,8 @@ class RTree3DFloat64:
             k: int = 9,
             p: int = 2,
             within: bool = True,
-            num_threads: int = 0
+            num_threads: int = 0,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = None
     ) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]]:
         ...
 
@@ -452,7 +633,8 @@ class RTree3DFloat64:
             epsilon: Optional[float] = None,
             smooth: float = 0,
             within: bool = True,
-            num_threads: int = 0
+            num_threads: int = 0,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = None
     ) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]]:
         ...
 
@@ -461,7 +643,8 @@ class RTree3DFloat64:
             coordinates: numpy.ndarray[numpy.float64],
             k: int = 4,
             within: bool = False,
-            num_threads: int = 0
+            num_threads: int = 0,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = None
     ) -> Tuple[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.float64]]:
         ...
 
@@ -499,7 +682,8 @@ class RTree3DFloat32:
             k: int = 9,
             p: int = 2,
             within: bool = True,
-            num_threads: int = 0
+            num_threads: int = 0,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = None
     ) -> Tuple[numpy.ndarray[numpy.float32], numpy.ndarray[numpy.float32]]:
         ...
 
@@ -512,7 +696,8 @@ class RTree3DFloat32:
             epsilon: Optional[float] = None,
             smooth: float = 0,
             within: bool = True,
-            num_threads: int = 0
+            num_threads: int = 0,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = None
     ) -> Tuple[numpy.ndarray[numpy.float32], numpy.ndarray[numpy.float32]]:
         ...
 
@@ -521,7 +706,8 @@ class RTree3DFloat32:
             coordinates: numpy.ndarray[numpy.float32],
             k: int = 4,
             within: bool = False,
-            num_threads: int = 0
+            num_threads: int = 0,
+            out: Optional[Tuple[numpy.ndarray, numpy.ndarray]] = None
     ) -> Tuple[numpy.ndarray[numpy.float32], numpy.ndarray[numpy.float32]]:
         ...
 
@@ -544,6 +730,23 @@ class FittingModel:
     Linear: 'FittingModel'
     Polynomial: 'FittingModel'
     Steffen: 'FittingModel'
+    CubicConvolution: 'FittingModel'
+    BSpline: 'FittingModel'
+
+
+class BicubicCache:
+    capacity: int
+    hits: int
+    misses: int
+
+    def __init__(self, capacity: int) -> None:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def clear(self) -> None:
+        ...
 
 
 def bicubic_float64(
@@ -559,7 +762,12 @@ def bicubic_float64(
         fitting_model: FittingModel = FittingModel.CSpline,
         boundary: AxisBoundary = AxisBoundary.Undef,
         bounds_error: bool = False,
-        num_threads: int = 0) -> numpy.ndarray[numpy.float64]:
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float64]] = None,
+        cache: Optional[BicubicCache] = None,
+        nz: int = 1,
+        nu: int = 1) -> numpy.ndarray[numpy.float64]:
     ...
 
 
@@ -576,41 +784,172 @@ def bicubic_float32(
         fitting_model: FittingModel = FittingModel.CSpline,
         boundary: AxisBoundary = AxisBoundary.Undef,
         bounds_error: bool = False,
-        num_threads: int = 0) -> numpy.ndarray[numpy.float64]:
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float64]] = None,
+        cache: Optional[BicubicCache] = None,
+        nz: int = 1,
+        nu: int = 1) -> numpy.ndarray[numpy.float64]:
     ...
 
 
-class BivariateInterpolator2D:
+def bicubic_narrow_float32(
+        grid: Union[Grid2DFloat32, Grid3DFloat32, TemporalGrid3DFloat32,
+                    Grid4DFloat32, TemporalGrid4DFloat32],
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        z: Optional[Union[numpy.ndarray[numpy.float64], numpy.
+                          ndarray[numpy.int64]]] = None,
+        u: Optional[numpy.ndarray[numpy.float64]] = None,
+        nx: int = 3,
+        ny: int = 3,
+        fitting_model: FittingModel = FittingModel.CSpline,
+        boundary: AxisBoundary = AxisBoundary.Undef,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float32]] = None,
+        cache: Optional[BicubicCache] = None,
+        nz: int = 1,
+        nu: int = 1) -> numpy.ndarray[numpy.float32]:
+    ...
+
+
+def bicubic_gradient_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        nx: int = 3,
+        ny: int = 3,
+        fitting_model: FittingModel = FittingModel.CSpline,
+        boundary: AxisBoundary = AxisBoundary.Undef,
+        mixed: bool = False,
+        bounds_error: bool = False,
+        num_threads: int = 0) -> Tuple[numpy.ndarray[numpy.float64], ...]:
+    ...
+
+
+def bicubic_gradient_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        nx: int = 3,
+        ny: int = 3,
+        fitting_model: FittingModel = FittingModel.CSpline,
+        boundary: AxisBoundary = AxisBoundary.Undef,
+        mixed: bool = False,
+        bounds_error: bool = False,
+        num_threads: int = 0) -> Tuple[numpy.ndarray[numpy.float64], ...]:
     ...
 
 
+def spline_coefficients_float64(
+    grid: Union[Grid2DFloat64, Grid3DFloat64, TemporalGrid3DFloat64,
+                Grid4DFloat64, TemporalGrid4DFloat64],
+    num_threads: int = 0
+) -> Union[Grid2DFloat64, Grid3DFloat64, TemporalGrid3DFloat64,
+           Grid4DFloat64, TemporalGrid4DFloat64]:
+    ...
+
+
+def spline_coefficients_float32(
+    grid: Union[Grid2DFloat32, Grid3DFloat32, TemporalGrid3DFloat32,
+                Grid4DFloat32, TemporalGrid4DFloat32],
+    num_threads: int = 0
+) -> Union[Grid2DFloat32, Grid3DFloat32, TemporalGrid3DFloat32,
+           Grid4DFloat32, TemporalGrid4DFloat32]:
+    ...
+
+
+class Distance:
+    Equirectangular: 'Distance'
+    Haversine: 'Distance'
+
+
+class BivariateInterpolator2D:
+    def __init__(self) -> None:
+        ...
+
+    def evaluate_batch(
+            self, p: numpy.ndarray[numpy.float64],
+            p0: numpy.ndarray[numpy.float64],
+            p1: numpy.ndarray[numpy.float64],
+            q: numpy.ndarray[numpy.float64]
+    ) -> numpy.ndarray[numpy.float64]:
+        ...
+
+
 class Bilinear2D(BivariateInterpolator2D):
     ...
 
 
 class InverseDistanceWeighting2D(BivariateInterpolator2D):
-    ...
+    def __init__(self, p: int = 2,
+                 distance: Distance = Distance.Haversine) -> None:
+        ...
 
 
 class Nearest2D(BivariateInterpolator2D):
+    def __init__(self, distance: Distance = Distance.Haversine) -> None:
+        ...
+
+
+def bilinear_gradient_float64(
+        grid: Grid2DFloat64,
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        mixed: bool = False,
+        bounds_error: bool = False,
+        num_threads: int = 0) -> Tuple[numpy.ndarray[numpy.float64], ...]:
+    ...
+
+
+def bilinear_gradient_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        mixed: bool = False,
+        bounds_error: bool = False,
+        num_threads: int = 0) -> Tuple[numpy.ndarray[numpy.float64], ...]:
+    ...
+
+
+def bivariate_float64(
+        grid: Union[Grid2DFloat64, MultiGrid2DFloat64],
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float64]] = None
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
-def bivariate_float64(grid: Grid2DFloat64,
-                      x: numpy.ndarray[numpy.float64],
-                      y: numpy.ndarray[numpy.float64],
-                      interpolator: BivariateInterpolator2D,
-                      bounds_error: bool = False,
-                      num_threads: int = 0) -> numpy.ndarray[numpy.float64]:
+def bivariate_float32(
+        grid: Union[Grid2DFloat32, MultiGrid2DFloat32],
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float64]] = None
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
-def bivariate_float32(grid: Grid2DFloat32,
-                      x: numpy.ndarray[numpy.float32],
-                      y: numpy.ndarray[numpy.float32],
-                      interpolator: BivariateInterpolator2D,
-                      bounds_error: bool = False,
-                      num_threads: int = 0) -> numpy.ndarray[numpy.float32]:
+def bivariate_single_float32(
+        grid: Grid2DFloat32,
+        x: numpy.ndarray[numpy.float32],
+        y: numpy.ndarray[numpy.float32],
+        interpolator: BivariateInterpolator2D,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float32]] = None
+) -> numpy.ndarray[numpy.float32]:
     ...
 
 
@@ -623,11 +962,14 @@ class Bilinear3D(BivariateInterpolator3D):
 
 
 class InverseDistanceWeighting3D(BivariateInterpolator3D):
-    ...
+    def __init__(self, p: int = 2,
+                 distance: Distance = Distance.Haversine) -> None:
+        ...
 
 
 class Nearest3D(BivariateInterpolator3D):
-    ...
+    def __init__(self, distance: Distance = Distance.Haversine) -> None:
+        ...
 
 
 class TemporalBivariateInterpolator3D:
@@ -639,37 +981,167 @@ class TemporalBilinear3D(TemporalBivariateInterpolator3D):
 
 
 class TemporalInverseDistanceWeighting3D(TemporalBivariateInterpolator3D):
-    ...
+    def __init__(self, p: int = 2,
+                 distance: Distance = Distance.Haversine) -> None:
+        ...
 
 
 class TemporalNearest3D(TemporalBivariateInterpolator3D):
+    def __init__(self, distance: Distance = Distance.Haversine) -> None:
+        ...
+
+
+def trivariate_float64(
+        grid: Union[Grid3DFloat64, TemporalGrid3DFloat64, MultiGrid3DFloat64,
+                    TemporalMultiGrid3DFloat64],
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        z: numpy.ndarray[numpy.float64],
+        interpolator: Union[BivariateInterpolator3D,
+                            TemporalBivariateInterpolator3D],
+        z_method: Optional[str] = None,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float64]] = None
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
-def trivariate_float64(grid: Union[Grid3DFloat64, TemporalGrid3DFloat64],
-                       x: numpy.ndarray[numpy.float64],
-                       y: numpy.ndarray[numpy.float64],
-                       z: numpy.ndarray[numpy.float64],
-                       interpolator: Union[BivariateInterpolator3D,
-                                           TemporalBivariateInterpolator3D],
-                       z_method: Optional[str] = None,
-                       bounds_error: bool = False,
-                       num_threads: int = 0) -> numpy.ndarray[numpy.float64]:
+def trivariate_float32(
+        grid: Union[Grid3DFloat32, TemporalGrid3DFloat32, MultiGrid3DFloat32,
+                    TemporalMultiGrid3DFloat32],
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        z: numpy.ndarray[numpy.float64],
+        interpolator: Union[BivariateInterpolator3D,
+                            TemporalBivariateInterpolator3D],
+        z_method: Optional[str] = None,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float64]] = None
+) -> numpy.ndarray[numpy.float64]:
     ...
 
 
-def trivariate_float32(grid: Union[Grid3DFloat32, TemporalGrid3DFloat32],
-                       x: numpy.ndarray[numpy.float64],
-                       y: numpy.ndarray[numpy.float64],
-                       z: numpy.ndarray[numpy.float64],
-                       interpolator: Union[BivariateInterpolator3D,
-                                           TemporalBivariateInterpolator3D],
-                       z_method: Optional[str] = None,
-                       bounds_error: bool = False,
-                       num_threads: int = 0) -> numpy.ndarray[numpy.float64]:
+def trivariate_single_float32(
+        grid: Union[Grid3DFloat32, TemporalGrid3DFloat32],
+        x: numpy.ndarray[numpy.float32],
+        y: numpy.ndarray[numpy.float32],
+        z: Union[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.int64]],
+        interpolator: Union[BivariateInterpolator3D,
+                            TemporalBivariateInterpolator3D],
+        z_method: Optional[str] = None,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        spatial_sort: bool = False,
+        out: Optional[numpy.ndarray[numpy.float32]] = None
+) -> numpy.ndarray[numpy.float32]:
     ...
 
 
+class BivariatePlan:
+    x: Axis
+    y: Axis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 x_values: numpy.ndarray[numpy.float64],
+                 y_values: numpy.ndarray[numpy.float64],
+                 interpolator: BivariateInterpolator2D,
+                 bounds_error: bool = False,
+                 num_threads: int = 0) -> None:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+    def apply(self,
+              grid: Union[Grid2DFloat64, Grid2DFloat32],
+              num_threads: int = 0,
+              out: Optional[numpy.ndarray[numpy.float64]] = None
+              ) -> numpy.ndarray[numpy.float64]:
+        ...
+
+
+class TrivariatePlan:
+    x: Axis
+    y: Axis
+    z: Axis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: Axis,
+                 x_values: numpy.ndarray[numpy.float64],
+                 y_values: numpy.ndarray[numpy.float64],
+                 z_values: numpy.ndarray[numpy.float64],
+                 interpolator: BivariateInterpolator3D,
+                 z_method: Optional[str] = None,
+                 bounds_error: bool = False,
+                 num_threads: int = 0) -> None:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+    def apply(self,
+              grid: Union[Grid3DFloat64, Grid3DFloat32],
+              num_threads: int = 0,
+              out: Optional[numpy.ndarray[numpy.float64]] = None
+              ) -> numpy.ndarray[numpy.float64]:
+        ...
+
+
+class TemporalTrivariatePlan:
+    x: Axis
+    y: Axis
+    z: TemporalAxis
+
+    def __getstate__(self) -> tuple:
+        ...
+
+    def __init__(self,
+                 x: Axis,
+                 y: Axis,
+                 z: TemporalAxis,
+                 x_values: numpy.ndarray[numpy.float64],
+                 y_values: numpy.ndarray[numpy.float64],
+                 z_values: numpy.ndarray[numpy.int64],
+                 interpolator: TemporalBivariateInterpolator3D,
+                 z_method: Optional[str] = None,
+                 bounds_error: bool = False,
+                 num_threads: int = 0) -> None:
+        ...
+
+    def __len__(self) -> int:
+        ...
+
+    def __setstate__(self, state: tuple) -> None:
+        ...
+
+    def apply(self,
+              grid: Union[TemporalGrid3DFloat64, TemporalGrid3DFloat32],
+              num_threads: int = 0,
+              out: Optional[numpy.ndarray[numpy.float64]] = None
+              ) -> numpy.ndarray[numpy.float64]:
+        ...
+
+
 def quadrivariate_float64(grid: Union[Grid4DFloat64, TemporalGrid4DFloat64],
                           x: numpy.ndarray[numpy.float64],
                           y: numpy.ndarray[numpy.float64],
@@ -680,21 +1152,41 @@ def quadrivariate_float64(grid: Union[Grid4DFloat64, TemporalGrid4DFloat64],
                           z_method: Optional[str] = None,
                           u_method: Optional[str] = None,
                           bounds_error: bool = False,
-                          num_threads: int = 0
+                          num_threads: int = 0,
+                          out: Optional[numpy.ndarray[numpy.float64]] = None
                           ) -> numpy.ndarray[numpy.float64]:
     ...
 
 
-def quadrivariate_float32(grid: Union[Grid4DFloat64, TemporalGrid4DFloat64],
-                          x: numpy.ndarray[numpy.float64],
-                          y: numpy.ndarray[numpy.float64],
-                          z: numpy.ndarray[numpy.float64],
-                          u: numpy.ndarray[numpy.float64],
-                          interpolator: Union[BivariateInterpolator3D,
-                                              TemporalBivariateInterpolator3D],
-                          z_method: Optional[str] = None,
-                          u_method: Optional[str] = None,
-                          bounds_error: bool = False,
-                          num_threads: int = 0
-                          ) -> numpy.ndarray[numpy.float64]:
+def quadrivariate_float32(
+        grid: Union[Grid4DFloat32, TemporalGrid4DFloat32],
+        x: numpy.ndarray[numpy.float64],
+        y: numpy.ndarray[numpy.float64],
+        z: numpy.ndarray[numpy.float64],
+        u: numpy.ndarray[numpy.float64],
+        interpolator: Union[BivariateInterpolator3D,
+                            TemporalBivariateInterpolator3D],
+        z_method: Optional[str] = None,
+        u_method: Optional[str] = None,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        out: Optional[numpy.ndarray[numpy.float64]] = None
+) -> numpy.ndarray[numpy.float64]:
+    ...
+
+
+def quadrivariate_single_float32(
+        grid: Union[Grid4DFloat32, TemporalGrid4DFloat32],
+        x: numpy.ndarray[numpy.float32],
+        y: numpy.ndarray[numpy.float32],
+        z: Union[numpy.ndarray[numpy.float64], numpy.ndarray[numpy.int64]],
+        u: numpy.ndarray[numpy.float32],
+        interpolator: Union[BivariateInterpolator3D,
+                            TemporalBivariateInterpolator3D],
+        z_method: Optional[str] = None,
+        u_method: Optional[str] = None,
+        bounds_error: bool = False,
+        num_threads: int = 0,
+        out: Optional[numpy.ndarray[numpy.float32]] = None
+) -> numpy.ndarray[numpy.float32]:
     ...
@@ -0,0 +1,172 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/shared_memory.hpp"
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pyinterp::detail {
+
+/// Identifies the segments created by this class
+static constexpr uint64_t kMagic = 0x7079696e74657270ULL;
+
+#ifndef _WIN32
+
+/// Maps the segment referenced by the file descriptor in memory
+static auto map_segment(const int fd, const size_t length) -> void* {
+  auto* ptr =
+      mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  auto code = errno;
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    throw std::system_error(code, std::generic_category(), "mmap");
+  }
+  return ptr;
+}
+
+auto SharedMemory::create(const std::string& name, const size_t size)
+    -> SharedMemory {
+  auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), name);
+  }
+  auto length = kAlignment + size;
+  if (ftruncate(fd, static_cast<off_t>(length)) == -1) {
+    auto code = errno;
+    close(fd);
+    shm_unlink(name.c_str());
+    throw std::system_error(code, std::generic_category(), name);
+  }
+  void* ptr;
+  try {
+    ptr = map_segment(fd, length);
+  } catch (...) {
+    shm_unlink(name.c_str());
+    throw;
+  }
+  auto* header = new (ptr) Header{};
+  header->size = size;
+  header->ref_count.store(1, std::memory_order_relaxed);
+  // The segment becomes visible to the other processes only once the header
+  // is initialized.
+  header->magic.store(kMagic, std::memory_order_release);
+  return SharedMemory(name, header, length);
+}
+
+auto SharedMemory::attach(const std::string& name) -> SharedMemory {
+  auto fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), name);
+  }
+  struct stat info {};
+  if (fstat(fd, &info) == -1) {
+    auto code = errno;
+    close(fd);
+    throw std::system_error(code, std::generic_category(), name);
+  }
+  auto length = static_cast<size_t>(info.st_size);
+  if (length < kAlignment) {
+    close(fd);
+    throw std::runtime_error(name + " is not an initialized shared memory");
+  }
+  auto* header = reinterpret_cast<Header*>(map_segment(fd, length));
+  auto result = SharedMemory(name, header, length);
+  if (header->magic.load(std::memory_order_acquire) != kMagic ||
+      header->size + kAlignment > length) {
+    result.header_ = nullptr;
+    munmap(header, length);
+    throw std::runtime_error(name + " is not an initialized shared memory");
+  }
+  // The reference counter is incremented only if the segment is not being
+  // destroyed by another process.
+  auto count = header->ref_count.load(std::memory_order_relaxed);
+  do {
+    if (count <= 0) {
+      result.header_ = nullptr;
+      munmap(header, length);
+      throw std::runtime_error(name + " is being destroyed");
+    }
+  } while (!header->ref_count.compare_exchange_weak(
+      count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+  return result;
+}
+
+auto SharedMemory::unlink(const std::string& name) -> bool {
+  return shm_unlink(name.c_str()) == 0;
+}
+
+void SharedMemory::release() noexcept {
+  if (header_ == nullptr) {
+    return;
+  }
+  if (header_->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    shm_unlink(name_.c_str());
+  }
+  munmap(header_, length_);
+  header_ = nullptr;
+}
+
+#else
+
+auto SharedMemory::create(const std::string& /*name*/, const size_t /*size*/)
+    -> SharedMemory {
+  throw std::runtime_error("shared memory is not supported on this platform");
+}
+
+auto SharedMemory::attach(const std::string& /*name*/) -> SharedMemory {
+  throw std::runtime_error("shared memory is not supported on this platform");
+}
+
+auto SharedMemory::unlink(const std::string& /*name*/) -> bool {
+  return false;
+}
+
+void SharedMemory::release() noexcept {}
+
+#endif
+
+SharedMemory::~SharedMemory() { release(); }
+
+SharedMemory::SharedMemory(SharedMemory&& rhs) noexcept
+    : name_(std::move(rhs.name_)), header_(rhs.header_), length_(rhs.length_) {
+  rhs.header_ = nullptr;
+  rhs.length_ = 0;
+}
+
+auto SharedMemory::operator=(SharedMemory&& rhs) noexcept -> SharedMemory& {
+  if (this != &rhs) {
+    release();
+    name_ = std::move(rhs.name_);
+    header_ = rhs.header_;
+    length_ = rhs.length_;
+    rhs.header_ = nullptr;
+    rhs.length_ = 0;
+  }
+  return *this;
+}
+
+auto SharedMemory::size() const noexcept -> size_t {
+  return header_ == nullptr ? 0 : header_->size;
+}
+
+auto SharedMemory::ref_count() const noexcept -> int64_t {
+  return header_ == nullptr ? 0
+                            : header_->ref_count.load(std::memory_order_relaxed);
+}
+
+auto SharedMemory::data() const noexcept -> void* {
+  return header_ == nullptr ? nullptr
+                            : reinterpret_cast<uint8_t*>(header_) + kAlignment;
+}
+
+}  // namespace pyinterp::detail
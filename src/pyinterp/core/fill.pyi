@@ -9,6 +9,11 @@ class FirstGuess:
     ZonalAverage: 'FirstGuess'
 
 
+class Sweep:
+    RedBlack: 'Sweep'
+    Pipelined: 'Sweep'
+
+
 class ValueType:
     Undefined: 'Undefined'
     Defined: 'Defined'
@@ -39,7 +44,8 @@ def gauss_seidel_float64(grid: numpy.ndarray[numpy.float64],
                          max_iterations: int = 2000,
                          epsilon: float = 0.0001,
                          relaxation: float = 1.0,
-                         num_thread: int = 0) -> Tuple[int, float]:
+                         num_thread: int = 0,
+                         sweep: Sweep = Sweep.RedBlack) -> Tuple[int, float]:
     ...
 
 
@@ -49,5 +55,24 @@ def gauss_seidel_float32(grid: numpy.ndarray[numpy.float32],
                          max_iterations: int = 2000,
                          epsilon: float = 0.0001,
                          relaxation: float = 1.0,
-                         num_thread: int = 0) -> Tuple[int, float]:
+                         num_thread: int = 0,
+                         sweep: Sweep = Sweep.RedBlack) -> Tuple[int, float]:
+    ...
+
+
+def multigrid_float64(grid: numpy.ndarray[numpy.float64],
+                      first_guess: FirstGuess = FirstGuess.ZonalAverage,
+                      is_circle: bool = True,
+                      max_iterations: int = 100,
+                      epsilon: float = 0.0001,
+                      num_thread: int = 0) -> Tuple[int, float]:
+    ...
+
+
+def multigrid_float32(grid: numpy.ndarray[numpy.float32],
+                      first_guess: FirstGuess = FirstGuess.ZonalAverage,
+                      is_circle: bool = True,
+                      max_iterations: int = 100,
+                      epsilon: float = 0.0001,
+                      num_thread: int = 0) -> Tuple[int, float]:
     ...
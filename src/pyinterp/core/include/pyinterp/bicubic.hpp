@@ -3,28 +3,74 @@
 // All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
+#include <array>
+#include <cstdint>
 #include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/lru_cache.hpp"
 #include "pyinterp/detail/math/bicubic.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/output.hpp"
 
 namespace pyinterp {
 
 /// Fitting model
 enum FittingModel {
-  kLinear,           //!< Linear interpolation
-  kPolynomial,       //!< Polynomial interpolation
-  kCSpline,          //!< Cubic spline with natural boundary conditions.
-  kCSplinePeriodic,  //!< Cubic spline with periodic boundary conditions.
-  kAkima,            //!< Non-rounded Akima spline with natural boundary
-                     //!< conditions
-  kAkimaPeriodic,    //!< Non-rounded Akima spline with periodic boundary
-                     //!< conditions
-  kSteffen           //!< Steffen’s method guarantees the monotonicity of
-                     //!< the interpolating function between the given
-                     //!< data points.
+  kLinear,            //!< Linear interpolation
+  kPolynomial,        //!< Polynomial interpolation
+  kCSpline,           //!< Cubic spline with natural boundary conditions.
+  kCSplinePeriodic,   //!< Cubic spline with periodic boundary conditions.
+  kAkima,             //!< Non-rounded Akima spline with natural boundary
+                      //!< conditions
+  kAkimaPeriodic,     //!< Non-rounded Akima spline with periodic boundary
+                      //!< conditions
+  kSteffen,           //!< Steffen’s method guarantees the monotonicity of
+                      //!< the interpolating function between the given
+                      //!< data points.
+  kCubicConvolution,  //!< Cubic convolution of Keys, evaluated without
+                      //!< fitting splines on the nodes of regular grids.
+  kBSpline            //!< Cubic B-spline, evaluated on the coefficients
+                      //!< computed by spline_coefficients.
 };
 
+/// Cell of a grid interpolated by a fitting model
+struct BicubicCell {
+  uint64_t grid;               //!< Identifier of the values of the grid
+  int64_t ix;                  //!< First index of the cell on the X-Axis
+  int64_t iy;                  //!< First index of the cell on the Y-Axis
+  uint32_t nx;                 //!< Half size of the window in abscissa
+  uint32_t ny;                 //!< Half size of the window in ordinate
+  FittingModel fitting_model;  //!< Fitting model
+  axis::Boundary boundary;     //!< Boundary handling
+
+  /// Compares two cells
+  inline auto operator==(const BicubicCell& rhs) const noexcept -> bool {
+    return grid == rhs.grid && ix == rhs.ix && iy == rhs.iy && nx == rhs.nx &&
+           ny == rhs.ny && fitting_model == rhs.fitting_model &&
+           boundary == rhs.boundary;
+  }
+};
+
+/// Hash function of the cells
+struct BicubicCellHash {
+  inline auto operator()(const BicubicCell& cell) const noexcept -> size_t {
+    auto result = static_cast<size_t>(cell.grid);
+    for (auto item : {static_cast<size_t>(cell.ix),
+                      static_cast<size_t>(cell.iy),
+                      static_cast<size_t>(cell.nx) << 16U | cell.ny,
+                      static_cast<size_t>(cell.fitting_model) << 8U |
+                          static_cast<size_t>(cell.boundary)}) {
+      result ^= item + 0x9e3779b97f4a7c15ULL + (result << 6U) + (result >> 2U);
+    }
+    return result;
+  }
+};
+
+/// Cache of the coefficients of the bicubic polynomials interpolating the
+/// most recently used cells of the grids.
+using BicubicCache =
+    detail::LruCache<BicubicCell, std::array<double, 16>, BicubicCellHash>;
+
 /// Extension of cubic interpolation for interpolating data points on a
 /// two-dimensional regular grid. The interpolated surface is smoother than
 /// corresponding surfaces obtained by bilinear interpolation or
@@ -35,6 +81,20 @@ template <typename Type>
 auto bicubic(const Grid2D<Type>& grid, const pybind11::array_t<double>& x,
              const pybind11::array_t<double>& y, size_t nx, size_t ny,
              FittingModel fitting_model, axis::Boundary boundary,
-             bool bounds_error, size_t num_threads)
+             bool bounds_error, size_t num_threads, bool spatial_sort,
+             const Output& out, BicubicCache* cache)
     -> pybind11::array_t<double>;
+
+/// Bicubic interpolation and calculation of the partial derivatives of the
+/// interpolated surface: returns the values interpolated, df/dx, df/dy and
+/// if mixed is true d²f/dxdy.
+///
+/// @tparam Type The type of data used by the numerical grid.
+template <typename Type>
+auto bicubic_gradient(const Grid2D<Type>& grid,
+                      const pybind11::array_t<double>& x,
+                      const pybind11::array_t<double>& y, size_t nx,
+                      size_t ny, FittingModel fitting_model,
+                      axis::Boundary boundary, bool mixed, bool bounds_error,
+                      size_t num_threads) -> pybind11::tuple;
 }  // namespace pyinterp
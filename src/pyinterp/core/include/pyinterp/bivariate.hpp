@@ -5,11 +5,19 @@
 #pragma once
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <memory>
+#include <type_traits>
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math/bivariate.hpp"
+#include "pyinterp/detail/math/regular_bilinear.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/ndarray.hpp"
+#include "pyinterp/output.hpp"
+#include "pyinterp/spatial_sort.hpp"
 
 namespace pyinterp {
 
@@ -34,12 +42,20 @@ class Bilinear : public detail::math::Bilinear<Point, T> {
 template <template <class> class Point, typename T>
 class Nearest : public detail::math::Nearest<Point, T> {
  public:
+  using detail::math::Nearest<Point, T>::Nearest;
+
   [[nodiscard]] auto getstate() const -> pybind11::tuple {
-    return pybind11::make_tuple();
+    return pybind11::make_tuple(this->distance());
   }
 
-  static auto setstate(const pybind11::tuple & /*tuple*/) -> Nearest {
-    return Nearest();
+  /// The states written by the previous releases, without the distance,
+  /// are also accepted.
+  static auto setstate(const pybind11::tuple& tuple) -> Nearest {
+    if (tuple.size() > 1) {
+      throw std::runtime_error("invalid state");
+    }
+    return Nearest(tuple.empty() ? detail::math::kHaversine
+                                 : tuple[0].cast<detail::math::Distance>());
   }
 };
 
@@ -52,19 +68,215 @@ class InverseDistanceWeighting
                                                T>::InverseDistanceWeighting;
 
   [[nodiscard]] auto getstate() const -> pybind11::tuple {
-    return pybind11::make_tuple(this->exp());
+    return pybind11::make_tuple(this->exp(), this->distance());
   }
 
+  /// The states written by the previous releases, without the distance,
+  /// are also accepted.
   static auto setstate(const pybind11::tuple& tuple)
       -> InverseDistanceWeighting {
-    if (tuple.size() != 1) {
+    if (tuple.size() != 1 && tuple.size() != 2) {
       throw std::runtime_error("invalid state");
     }
 
-    return InverseDistanceWeighting(tuple[0].cast<int>());
+    return InverseDistanceWeighting(
+        tuple[0].cast<int>(), tuple.size() == 1
+                                  ? detail::math::kHaversine
+                                  : tuple[1].cast<detail::math::Distance>());
   }
 };
 
+/// Bilinear interpolation of a grid whose both axes are evenly spaced: the
+/// points are processed by blocks, without searching the axes.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam Type The type of data used by the numerical grid.
+template <typename Coordinate, typename Type>
+void bilinear_regular(const Grid2D<Type>& grid, const FlatView<Coordinate>& x,
+                      const FlatView<Coordinate>& y, Coordinate* result,
+                      const bool bounds_error,
+                      const size_t num_threads) {
+  using RegularBilinear = detail::math::RegularBilinear<Coordinate>;
+
+  // Captures the detected exceptions in the calculation function
+  // (only the last exception captured is kept)
+  auto except = std::exception_ptr(nullptr);
+
+  // Access to the shared pointer outside the loop to avoid data races
+  const auto& x_axis = *grid.x();
+  const auto& y_axis = *grid.y();
+  const auto interpolator = RegularBilinear(x_axis, y_axis);
+
+  detail::dispatch(
+      [&](size_t start, size_t end) {
+        try {
+          auto xi = std::array<Coordinate, RegularBilinear::kBlockSize>();
+          auto yi = std::array<Coordinate, RegularBilinear::kBlockSize>();
+          auto zi = std::array<Coordinate, RegularBilinear::kBlockSize>();
+
+          for (size_t ix = start; ix < end; ix += RegularBilinear::kBlockSize) {
+            auto size = std::min(RegularBilinear::kBlockSize, end - ix);
+            for (size_t jx = 0; jx < size; ++jx) {
+              xi[jx] = x(ix + jx);
+              yi[jx] = y(ix + jx);
+            }
+            interpolator.evaluate(
+                xi.data(), yi.data(), size,
+                [&](const int64_t i, const int64_t j) {
+                  return grid.value(i, j);
+                },
+                zi.data());
+            for (size_t jx = 0; jx < size; ++jx) {
+              // An undefined value may also come from the grid: the axes
+              // are searched to find out if the point is out of bounds.
+              if (bounds_error && std::isnan(zi[jx])) {
+                if (!x_axis.find_indexes(xi[jx]).has_value()) {
+                  Grid2D<Type>::index_error(x_axis, xi[jx], "x");
+                }
+                if (!y_axis.find_indexes(yi[jx]).has_value()) {
+                  Grid2D<Type>::index_error(y_axis, yi[jx], "y");
+                }
+              }
+              result[ix + jx] = zi[jx];
+            }
+          }
+        } catch (...) {
+          except = std::current_exception();
+        }
+      },
+      x.size(), num_threads);
+
+  if (except != nullptr) {
+    std::rethrow_exception(except);
+  }
+}
+
+/// Interpolation of a bivariate function by an interpolator implemented in
+/// Python, whose method "evaluate_batch" is called once for each batch of
+/// points instead of calling "evaluate" for each point.
+///
+/// The method receives the arrays p, p0 and p1, of shape (n, 2), holding the
+/// coordinates of the points and of the corners (x0, y0) and (x1, y1) of
+/// their cells, and the array q, of shape (n, 4), holding the values of the
+/// grid at (x0, y0), (x0, y1), (x1, y0) and (x1, y1). It returns the n
+/// values interpolated. The rows of the points located outside the grid are
+/// filled with NaN, and these points are set to NaN.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam Type The type of data used by the numerical grid.
+template <template <class> class Point, typename Coordinate, typename Type>
+void bivariate_batch(const Grid2D<Type>& grid, const FlatView<Coordinate>& x,
+                     const FlatView<Coordinate>& y,
+                     const pybind11::function& evaluate_batch,
+                     Coordinate* result, const bool bounds_error,
+                     const size_t num_threads) {
+  // Number of points handed to Python at once, which bounds the memory used
+  // by the arrays of the batch.
+  constexpr int64_t kBatchSize = 65536;
+  constexpr auto kNaN = std::numeric_limits<Coordinate>::quiet_NaN();
+
+  // Access to the shared pointer outside the loop to avoid data races
+  const auto& x_axis = *grid.x();
+  const auto& y_axis = *grid.y();
+
+  for (int64_t first = 0; first < x.size(); first += kBatchSize) {
+    auto size = std::min(kBatchSize, x.size() - first);
+    auto p = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{size, 2});
+    auto p0 = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{size, 2});
+    auto p1 = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{size, 2});
+    auto q = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer{size, 4});
+    auto* _p = p.mutable_data();
+    auto* _p0 = p0.mutable_data();
+    auto* _p1 = p1.mutable_data();
+    auto* _q = q.mutable_data();
+    auto is_inside = std::vector<uint8_t>(size);
+
+    {
+      pybind11::gil_scoped_release release;
+
+      // Captures the detected exceptions in the calculation function
+      // (only the last exception captured is kept)
+      auto except = std::exception_ptr(nullptr);
+
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            try {
+              for (size_t ix = start; ix < end; ++ix) {
+                auto x_indexes = x_axis.find_indexes(x(first + ix));
+                auto y_indexes = y_axis.find_indexes(y(first + ix));
+
+                if (x_indexes.has_value() && y_indexes.has_value()) {
+                  int64_t ix0;
+                  int64_t ix1;
+                  int64_t iy0;
+                  int64_t iy1;
+
+                  std::tie(ix0, ix1) = *x_indexes;
+                  std::tie(iy0, iy1) = *y_indexes;
+
+                  auto x0 = x_axis(ix0);
+                  auto x1 = x_axis(ix1);
+                  auto xi = static_cast<double>(x(first + ix));
+                  if (x_axis.is_angle()) {
+                    xi = detail::math::normalize_angle(xi, x0, 360.0);
+                    x1 = detail::math::normalize_angle(x1, x0, 360.0);
+                  }
+                  _p[ix * 2] = static_cast<Coordinate>(xi);
+                  _p[ix * 2 + 1] = y(first + ix);
+                  _p0[ix * 2] = static_cast<Coordinate>(x0);
+                  _p0[ix * 2 + 1] = static_cast<Coordinate>(y_axis(iy0));
+                  _p1[ix * 2] = static_cast<Coordinate>(x1);
+                  _p1[ix * 2 + 1] = static_cast<Coordinate>(y_axis(iy1));
+                  _q[ix * 4] = static_cast<Coordinate>(grid.value(ix0, iy0));
+                  _q[ix * 4 + 1] =
+                      static_cast<Coordinate>(grid.value(ix0, iy1));
+                  _q[ix * 4 + 2] =
+                      static_cast<Coordinate>(grid.value(ix1, iy0));
+                  _q[ix * 4 + 3] =
+                      static_cast<Coordinate>(grid.value(ix1, iy1));
+                  is_inside[ix] = 1;
+                } else {
+                  if (bounds_error) {
+                    if (!x_indexes.has_value()) {
+                      Grid2D<Type>::index_error(x_axis, x(first + ix), "x");
+                    }
+                    Grid2D<Type>::index_error(y_axis, y(first + ix), "y");
+                  }
+                  std::fill(_p + ix * 2, _p + ix * 2 + 2, kNaN);
+                  std::fill(_p0 + ix * 2, _p0 + ix * 2 + 2, kNaN);
+                  std::fill(_p1 + ix * 2, _p1 + ix * 2 + 2, kNaN);
+                  std::fill(_q + ix * 4, _q + ix * 4 + 4, kNaN);
+                }
+              }
+            } catch (...) {
+              except = std::current_exception();
+            }
+          },
+          size, num_threads);
+
+      if (except != nullptr) {
+        std::rethrow_exception(except);
+      }
+    }
+
+    auto values =
+        pybind11::array_t<Coordinate>::ensure(evaluate_batch(p, p0, p1, q));
+    if (!values || values.size() != size) {
+      throw std::invalid_argument(
+          "evaluate_batch must return an array of " + std::to_string(size) +
+          " values");
+    }
+    auto _values = FlatView<Coordinate>(values);
+    for (int64_t ix = 0; ix < size; ++ix) {
+      result[first + ix] = is_inside[ix] != 0 ? _values(ix) : kNaN;
+    }
+  }
+}
+
 /// Interpolation of bivariate function.
 ///
 /// @tparam Coordinate The type of data used by the interpolators.
@@ -73,17 +285,147 @@ template <template <class> class Point, typename Coordinate, typename Type>
 auto bivariate(const Grid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
                const pybind11::array_t<Coordinate>& y,
                const BivariateInterpolator<Point, Coordinate>* interpolator,
-               const bool bounds_error, const size_t num_threads)
+               const bool bounds_error, const size_t num_threads,
+               const bool spatial_sort = false,
+               const Output& out = std::nullopt)
     -> pybind11::array_t<Coordinate> {
-  pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y);
+  pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+
+  // The points are interpolated in the order of their position on the grid,
+  // then the results are put back in the order of the points provided.
+  if (spatial_sort) {
+    auto order = spatial_order(*grid.x(), x, *grid.y(), y, num_threads);
+    return scatter(bivariate<Point, Coordinate, Type>(
+                       grid, gather(x, order, num_threads),
+                       gather(y, order, num_threads), interpolator,
+                       bounds_error, num_threads),
+                   order, shape_of(x), num_threads, out);
+  }
+
+  auto size = x.size();
+  auto result = output_array<Coordinate>(out, shape_of(x));
+  auto _x = FlatView<Coordinate>(x);
+  auto _y = FlatView<Coordinate>(y);
+  auto* _result = result.mutable_data();
+
+  // The interpolators implemented in Python can process the points by
+  // batches, which avoids calling Python, with the GIL held, for each point.
+  if (auto evaluate_batch =
+          pybind11::get_overload(interpolator, "evaluate_batch")) {
+    bivariate_batch<Point, Coordinate, Type>(grid, _x, _y, evaluate_batch,
+                                             _result, bounds_error,
+                                             num_threads);
+    return result;
+  }
+
+  {
+    pybind11::gil_scoped_release release;
+
+    // Captures the detected exceptions in the calculation function
+    // (only the last exception captured is kept)
+    auto except = std::exception_ptr(nullptr);
+
+    // Access to the shared pointer outside the loop to avoid data races
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
+
+    // The loop is instantiated for the bilinear interpolator, so that the
+    // interpolation of each point does not go through a virtual call
+    detail::math::visit_bilinear(interpolator, [&](const auto& impl) {
+      using Interpolator = std::decay_t<decltype(impl)>;
+      if constexpr (std::is_same_v<Interpolator, detail::math::Bilinear<
+                                                     Point, Coordinate>>) {
+        if (detail::math::RegularBilinear<Coordinate>::is_suitable(x_axis,
+                                                                   y_axis)) {
+          bilinear_regular<Coordinate>(grid, _x, _y, _result, bounds_error,
+                                       num_threads);
+          return;
+        }
+      }
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            try {
+              for (size_t ix = start; ix < end; ++ix) {
+                auto x_indexes = x_axis.find_indexes(_x(ix));
+                auto y_indexes = y_axis.find_indexes(_y(ix));
+
+                if (x_indexes.has_value() && y_indexes.has_value()) {
+                  int64_t ix0;
+                  int64_t ix1;
+                  int64_t iy0;
+                  int64_t iy1;
+
+                  std::tie(ix0, ix1) = *x_indexes;
+                  std::tie(iy0, iy1) = *y_indexes;
+
+                  auto x0 = x_axis(ix0);
+                  auto x1 = x_axis(ix1);
+                  auto xi = static_cast<double>(_x(ix));
+                  if (x_axis.is_angle()) {
+                    // In the cell connecting the last and the first points
+                    // of a circle, x1 is located before x0 and must be
+                    // moved to the following period, as the query point.
+                    xi = detail::math::normalize_angle(xi, x0, 360.0);
+                    x1 = detail::math::normalize_angle(x1, x0, 360.0);
+                  }
+
+                  _result[ix] = impl.evaluate(
+                      Point<Coordinate>(xi, _y(ix)),
+                      Point<Coordinate>(x0, y_axis(iy0)),
+                      Point<Coordinate>(x1, y_axis(iy1)),
+                      static_cast<Coordinate>(grid.value(ix0, iy0)),
+                      static_cast<Coordinate>(grid.value(ix0, iy1)),
+                      static_cast<Coordinate>(grid.value(ix1, iy0)),
+                      static_cast<Coordinate>(grid.value(ix1, iy1)));
+
+                } else {
+                  if (bounds_error) {
+                    if (!x_indexes.has_value()) {
+                      Grid2D<Type>::index_error(x_axis, _x(ix), "x");
+                    }
+                    Grid2D<Type>::index_error(y_axis, _y(ix), "y");
+                  }
+                  _result[ix] = std::numeric_limits<Coordinate>::quiet_NaN();
+                }
+              }
+            } catch (...) {
+              except = std::current_exception();
+            }
+          },
+          size, num_threads);
+    });
+
+    if (except != nullptr) {
+      std::rethrow_exception(except);
+    }
+  }
+  return result;
+}
+
+/// Interpolation of several bivariate functions sharing the same axes.
+///
+/// The axes are searched and the weights of the interpolator are calculated
+/// only once per query point for all the variables stored in the grid.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam Type The type of data used by the numerical grid.
+template <template <class> class Point, typename Coordinate, typename Type>
+auto bivariate_multi(
+    const MultiGrid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
+    const pybind11::array_t<Coordinate>& y,
+    const BivariateInterpolator<Point, Coordinate>* interpolator,
+    const bool bounds_error, const size_t num_threads,
+    const Output& out = std::nullopt) -> pybind11::array_t<Coordinate> {
   pyinterp::detail::check_ndarray_shape("x", x, "y", y);
 
   auto size = x.size();
-  auto result =
-      pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _result = result.template mutable_unchecked<1>();
+  auto variables = grid.variables();
+  auto shape = shape_of(x);
+  shape.push_back(variables);
+  auto result = output_array<Coordinate>(out, shape);
+  auto _x = FlatView<Coordinate>(x);
+  auto _y = FlatView<Coordinate>(y);
+  auto* _result = result.mutable_data();
 
   {
     pybind11::gil_scoped_release release;
@@ -96,6 +438,119 @@ auto bivariate(const Grid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
     const auto& x_axis = *grid.x();
     const auto& y_axis = *grid.y();
 
+    detail::math::visit_bilinear(interpolator, [&](const auto& impl) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            try {
+              // Values of the variables for the four points of the cell
+              auto q =
+                  Eigen::Matrix<Coordinate, Eigen::Dynamic, 4>(variables, 4);
+
+              for (size_t ix = start; ix < end; ++ix) {
+                auto x_indexes = x_axis.find_indexes(_x(ix));
+                auto y_indexes = y_axis.find_indexes(_y(ix));
+                auto values = Eigen::Map<Eigen::Matrix<Coordinate, -1, 1>>(
+                    _result + ix * variables, variables);
+
+                if (x_indexes.has_value() && y_indexes.has_value()) {
+                  int64_t ix0;
+                  int64_t ix1;
+                  int64_t iy0;
+                  int64_t iy1;
+
+                  std::tie(ix0, ix1) = *x_indexes;
+                  std::tie(iy0, iy1) = *y_indexes;
+
+                  const auto* q00 = grid.values(ix0, iy0);
+                  const auto* q01 = grid.values(ix0, iy1);
+                  const auto* q10 = grid.values(ix1, iy0);
+                  const auto* q11 = grid.values(ix1, iy1);
+                  for (Eigen::Index kx = 0; kx < variables; ++kx) {
+                    q(kx, 0) = static_cast<Coordinate>(q00[kx]);
+                    q(kx, 1) = static_cast<Coordinate>(q01[kx]);
+                    q(kx, 2) = static_cast<Coordinate>(q10[kx]);
+                    q(kx, 3) = static_cast<Coordinate>(q11[kx]);
+                  }
+
+                  auto x0 = x_axis(ix0);
+                  auto x1 = x_axis(ix1);
+                  auto xi = static_cast<double>(_x(ix));
+                  if (x_axis.is_angle()) {
+                    xi = detail::math::normalize_angle(xi, x0, 360.0);
+                    x1 = detail::math::normalize_angle(x1, x0, 360.0);
+                  }
+
+                  impl.evaluate_variables(
+                      Point<Coordinate>(xi, _y(ix)),
+                      Point<Coordinate>(x0, y_axis(iy0)),
+                      Point<Coordinate>(x1, y_axis(iy1)), q, values);
+
+                } else {
+                  if (bounds_error) {
+                    if (!x_indexes.has_value()) {
+                      MultiGrid2D<Type>::index_error(x_axis, _x(ix), "x");
+                    }
+                    MultiGrid2D<Type>::index_error(y_axis, _y(ix), "y");
+                  }
+                  values.setConstant(
+                      std::numeric_limits<Coordinate>::quiet_NaN());
+                }
+              }
+            } catch (...) {
+              except = std::current_exception();
+            }
+          },
+          size, num_threads);
+    });
+
+    if (except != nullptr) {
+      std::rethrow_exception(except);
+    }
+  }
+  return result;
+}
+
+/// Bilinear interpolation of a bivariate function and calculation of the
+/// partial derivatives of the interpolated surface, with respect to the
+/// units of the axes. The cell containing each point is searched once for
+/// the value and its derivatives.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam Type The type of data used by the numerical grid.
+/// @return The values interpolated, df/dx, df/dy and if mixed is true
+/// d²f/dxdy.
+template <template <class> class Point, typename Coordinate, typename Type>
+auto bilinear_gradient(const Grid2D<Type>& grid,
+                       const pybind11::array_t<Coordinate>& x,
+                       const pybind11::array_t<Coordinate>& y,
+                       const bool mixed, const bool bounds_error,
+                       const size_t num_threads) -> pybind11::tuple {
+  pyinterp::detail::check_ndarray_shape("x", x, "y", y);
+
+  auto size = x.size();
+  auto count = mixed ? 4 : 3;
+  auto results = std::array<pybind11::array_t<Coordinate>, 4>();
+  auto pointers = std::array<Coordinate*, 4>();
+  for (auto ix = 0; ix < count; ++ix) {
+    results[ix] = pybind11::array_t<Coordinate>(
+        pybind11::array::ShapeContainer(shape_of(x)));
+    pointers[ix] = results[ix].mutable_data();
+  }
+  auto _x = FlatView<Coordinate>(x);
+  auto _y = FlatView<Coordinate>(y);
+
+  {
+    pybind11::gil_scoped_release release;
+
+    // Captures the detected exceptions in the calculation function
+    // (only the last exception captured is kept)
+    auto except = std::exception_ptr(nullptr);
+
+    // Access to the shared pointer outside the loop to avoid data races
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
+    const auto interpolator = detail::math::Bilinear<Point, Coordinate>();
+
     detail::dispatch(
         [&](size_t start, size_t end) {
           try {
@@ -113,20 +568,24 @@ auto bivariate(const Grid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
                 std::tie(iy0, iy1) = *y_indexes;
 
                 auto x0 = x_axis(ix0);
+                auto x1 = x_axis(ix1);
+                auto xi = static_cast<double>(_x(ix));
+                if (x_axis.is_angle()) {
+                  xi = detail::math::normalize_angle(xi, x0, 360.0);
+                  x1 = detail::math::normalize_angle(x1, x0, 360.0);
+                }
 
-                _result(ix) = interpolator->evaluate(
-                    Point<Coordinate>(
-                        x_axis.is_angle()
-                            ? detail::math::normalize_angle(_x(ix), x0, 360.0)
-                            : _x(ix),
-                        _y(ix)),
+                auto gradient = interpolator.gradient(
+                    Point<Coordinate>(xi, _y(ix)),
                     Point<Coordinate>(x0, y_axis(iy0)),
-                    Point<Coordinate>(x_axis(ix1), y_axis(iy1)),
+                    Point<Coordinate>(x1, y_axis(iy1)),
                     static_cast<Coordinate>(grid.value(ix0, iy0)),
                     static_cast<Coordinate>(grid.value(ix0, iy1)),
                     static_cast<Coordinate>(grid.value(ix1, iy0)),
                     static_cast<Coordinate>(grid.value(ix1, iy1)));
-
+                for (auto jx = 0; jx < count; ++jx) {
+                  pointers[jx][ix] = gradient[jx];
+                }
               } else {
                 if (bounds_error) {
                   if (!x_indexes.has_value()) {
@@ -134,7 +593,10 @@ auto bivariate(const Grid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
                   }
                   Grid2D<Type>::index_error(y_axis, _y(ix), "y");
                 }
-                _result(ix) = std::numeric_limits<Coordinate>::quiet_NaN();
+                for (auto jx = 0; jx < count; ++jx) {
+                  pointers[jx][ix] =
+                      std::numeric_limits<Coordinate>::quiet_NaN();
+                }
               }
             }
           } catch (...) {
@@ -147,9 +609,75 @@ auto bivariate(const Grid2D<Type>& grid, const pybind11::array_t<Coordinate>& x,
       std::rethrow_exception(except);
     }
   }
+  return mixed ? pybind11::make_tuple(results[0], results[1], results[2],
+                                      results[3])
+               : pybind11::make_tuple(results[0], results[1], results[2]);
+}
+
+/// Returns the interpolator calculating in single precision equivalent to the
+/// interpolator provided, or nullptr if the interpolator is implemented in
+/// Python.
+template <template <class> class Point>
+auto single_precision(const BivariateInterpolator<Point, double>* interpolator)
+    -> std::unique_ptr<BivariateInterpolator<Point, float>> {
+  auto result = std::unique_ptr<BivariateInterpolator<Point, float>>();
+  detail::math::visit(interpolator, [&](const auto& impl) {
+    using Interpolator = std::decay_t<decltype(impl)>;
+    if constexpr (std::is_same_v<Interpolator,
+                                 detail::math::Bilinear<Point, double>>) {
+      result = std::make_unique<detail::math::Bilinear<Point, float>>();
+    } else if constexpr (std::is_same_v<Interpolator,
+                                        detail::math::Nearest<Point, double>>) {
+      result = std::make_unique<detail::math::Nearest<Point, float>>(
+          impl.distance());
+    } else if constexpr (std::is_same_v<
+                             Interpolator,
+                             detail::math::InverseDistanceWeighting<Point,
+                                                                    double>>) {
+      result = std::make_unique<
+          detail::math::InverseDistanceWeighting<Point, float>>(
+          impl.exp(), impl.distance());
+    }
+  });
   return result;
 }
 
+/// Copies values calculated in double precision into an array of float32.
+inline auto narrow(const pybind11::array_t<double>& values, const Output& out)
+    -> pybind11::array_t<float> {
+  auto result = output_array<float>(out, shape_of(values));
+  std::copy(values.data(), values.data() + values.size(),
+            result.mutable_data());
+  return result;
+}
+
+/// Interpolation of a bivariate function in single precision: the
+/// coordinates are float32, the calculations are done in single precision
+/// and the values interpolated are returned as float32. The interpolators
+/// implemented in Python calculate in double precision, and their results
+/// are converted to float32.
+///
+/// @tparam Type The type of data used by the numerical grid.
+template <template <class> class Point, typename Type>
+auto bivariate_single(
+    const Grid2D<Type>& grid, const pybind11::array_t<float>& x,
+    const pybind11::array_t<float>& y,
+    const BivariateInterpolator<Point, double>* interpolator,
+    const bool bounds_error, const size_t num_threads,
+    const bool spatial_sort = false, const Output& out = std::nullopt)
+    -> pybind11::array_t<float> {
+  auto impl = single_precision(interpolator);
+  if (impl != nullptr) {
+    return bivariate<Point, float, Type>(grid, x, y, impl.get(), bounds_error,
+                                         num_threads, spatial_sort, out);
+  }
+  return narrow(bivariate<Point, double, Type>(
+                    grid, pybind11::array_t<double>::ensure(x),
+                    pybind11::array_t<double>::ensure(y), interpolator,
+                    bounds_error, num_threads, spatial_sort),
+                out);
+}
+
 template <template <class> class Point, typename T>
 void implement_bivariate_interpolator(pybind11::module& m,
                                       const std::string& prefix,
@@ -172,7 +700,19 @@ void implement_bivariate_interpolator(pybind11::module& m,
   /// BivariateInterpolator implemented here
   auto interpolator = pybind11::class_<CoordinateSystem, PyInterpolator>(
       m, (prefix + "BivariateInterpolator" + suffix).c_str(),
-      ("Bilinear interpolation in a " + suffix + " space").c_str());
+      ("Interpolator in a " + suffix + " space.\n\n"
+       "This class can be derived in Python to define a custom "
+       "interpolator. If the derived class defines the method "
+       "``evaluate_batch(p, p0, p1, q)``, the bivariate function calls it "
+       "once for each batch of points rather than calling ``evaluate`` for "
+       "each point: ``p``, ``p0`` and ``p1`` are arrays of shape (n, 2) "
+       "containing the coordinates of the points and of the corners of the "
+       "cells enclosing them, ``q`` an array of shape (n, 4) containing the "
+       "values of the corners ``(x0, y0)``, ``(x0, y1)``, ``(x1, y0)`` and "
+       "``(x1, y1)``. The method must return the n interpolated values. The "
+       "rows of the points outside the grid are set to NaN.")
+          .c_str())
+      .def(pybind11::init<>());
 
   pybind11::class_<Bilinear<Point, T>>(
       m, (prefix + "Bilinear" + suffix).c_str(), interpolator,
@@ -187,7 +727,8 @@ void implement_bivariate_interpolator(pybind11::module& m,
   pybind11::class_<Nearest<Point, T>>(
       m, (prefix + "Nearest" + suffix).c_str(), interpolator,
       ("Nearest interpolation in a " + suffix + " space").c_str())
-      .def(pybind11::init<>())
+      .def(pybind11::init<detail::math::Distance>(),
+           pybind11::arg("distance") = detail::math::kHaversine)
       .def(pybind11::pickle(
           [](const Nearest<Point, T>& self) { return self.getstate(); },
           [](const pybind11::tuple& state) {
@@ -198,7 +739,9 @@ void implement_bivariate_interpolator(pybind11::module& m,
       m, (prefix + "InverseDistanceWeighting" + suffix).c_str(), interpolator,
       ("Inverse distance weighting interpolation in a " + suffix + " space")
           .c_str())
-      .def(pybind11::init<int>(), pybind11::arg("p") = 2)
+      .def(pybind11::init<int, detail::math::Distance>(),
+           pybind11::arg("p") = 2,
+           pybind11::arg("distance") = detail::math::kHaversine)
       .def(pybind11::pickle(
           [](const InverseDistanceWeighting<Point, T>& self) {
             return self.getstate();
@@ -216,6 +759,8 @@ void implement_bivariate(pybind11::module& m, const std::string& suffix) {
         &bivariate<Point, Coordinate, Type>, pybind11::arg("grid"),
         pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("interpolator"),
         pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("spatial_sort") = false,
+        pybind11::arg("out") = pybind11::none(),
         (R"__doc__(
 Interpolate the values provided on the defined bivariate function.
 
@@ -234,8 +779,100 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    spatial_sort (bool, optional): If True, the points are interpolated in
+        the order of their position on the grid, which limits the cache
+        misses when the points are provided in a random order, and the
+        results are returned in the order of the points provided. Sorting
+        the points pays off from about 100,000 points. Defaults to
+        ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result. It must not overlap the coordinates.
+Return:
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates.
+)__doc__")
+            .c_str());
+
+  m.def(("bilinear_gradient_" + function_suffix).c_str(),
+        &bilinear_gradient<Point, Coordinate, Type>, pybind11::arg("grid"),
+        pybind11::arg("x"), pybind11::arg("y"),
+        pybind11::arg("mixed") = false, pybind11::arg("bounds_error") = false,
+        pybind11::arg("num_threads") = 0,
+        (R"__doc__(
+Bilinear interpolation of the values provided on the defined bivariate
+function, and calculation of the partial derivatives of the interpolated
+surface. The cell containing each point is searched only once.
+
+Args:
+    grid (pyinterp.core.Grid2D)__doc__" +
+         suffix +
+         R"__doc__(): Grid containing the values to be interpolated.
+    x (numpy.ndarray): X-values
+    y (numpy.ndarray): Y-values
+    mixed (bool, optional): If True, the mixed derivative d²f/dxdy is also
+      calculated. Defaults to ``False``.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    tuple: The values interpolated, df/dx, df/dy, and d²f/dxdy if
+    requested, arrays of the shape of the coordinates. The derivatives are
+    expressed per unit of the axes.
+)__doc__")
+            .c_str());
+
+  if constexpr (std::is_same_v<Type, float>) {
+    m.def(("bivariate_single_" + function_suffix).c_str(),
+          &bivariate_single<Point, Type>, pybind11::arg("grid"),
+          pybind11::arg("x"), pybind11::arg("y"),
+          pybind11::arg("interpolator"), pybind11::arg("bounds_error") = false,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("spatial_sort") = false,
+          pybind11::arg("out") = pybind11::none(),
+          R"__doc__(
+Interpolate the values provided on the defined bivariate function, in single
+precision: the coordinates are converted to float32, and the calculations are
+done, and the values interpolated are returned, in float32, which halves the
+memory used by the results. The arguments are those of
+:py:func:`pyinterp.core.bivariate_float32`.
+)__doc__");
+  }
+
+  m.def(("bivariate_" + function_suffix).c_str(),
+        &bivariate_multi<Point, Coordinate, Type>, pybind11::arg("grid"),
+        pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("interpolator"),
+        pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
+        (R"__doc__(
+Interpolate the values provided on several bivariate functions sharing the
+same axes.
+
+Args:
+    grid (pyinterp.core.MultiGrid2D)__doc__" +
+         suffix +
+         R"__doc__(): Grid containing the values to be interpolated.
+    x (numpy.ndarray): X-values
+    y (numpy.ndarray): Y-values
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+      used to interpolate.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result. It must not overlap the coordinates.
 Return:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates followed by the number of variables stored in the grid.
 )__doc__")
             .c_str());
 }
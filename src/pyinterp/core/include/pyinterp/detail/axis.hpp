@@ -521,4 +521,34 @@ class Axis {
   }
 };
 
+/// Searches the indexes of an axis framing a coordinate, remembering the last
+/// coordinate searched: the consecutive queries sharing the same coordinate,
+/// such as the observations of the same time step, search the axis only once.
+template <typename T>
+class AxisSearch {
+ public:
+  /// Default constructor
+  explicit AxisSearch(const Axis<T>& axis) : axis_(axis) {}
+
+  /// Given a coordinate position, find grids elements around it.
+  ///
+  /// @see Axis::find_indexes
+  [[nodiscard]] inline auto find_indexes(const T coordinate)
+      -> const std::optional<std::tuple<int64_t, int64_t>>& {
+    if (!coordinate_.has_value() || *coordinate_ != coordinate) {
+      indexes_ = axis_.find_indexes(coordinate);
+      coordinate_ = coordinate;
+    }
+    return indexes_;
+  }
+
+ private:
+  /// Axis searched
+  const Axis<T>& axis_;
+  /// Last coordinate searched
+  std::optional<T> coordinate_{};
+  /// Indexes framing the last coordinate searched
+  std::optional<std::tuple<int64_t, int64_t>> indexes_{};
+};
+
 }  // namespace pyinterp::detail
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace pyinterp::detail {
 
@@ -19,18 +20,30 @@ auto eigen_shape(const Array& array) -> std::string {
   return ss.str();
 }
 
+/// Get a string representing a shape, formatted as a Python tuple.
+///
+/// @param shape size of each dimension
+template <typename Shape>
+auto shape_string(const Shape& shape) -> std::string {
+  std::stringstream ss;
+  ss << "(";
+  for (size_t ix = 0; ix < shape.size(); ++ix) {
+    ss << (ix == 0 ? "" : ", ") << shape[ix];
+  }
+  ss << (shape.size() == 1 ? ",)" : ")");
+  return ss.str();
+}
+
 /// Get a string representing the shape of a tensor.
 ///
 /// @param array tensor to process
 template <typename Array>
 auto ndarray_shape(const Array& array) -> std::string {
-  std::stringstream ss;
-  ss << "(";
+  auto shape = std::vector<int64_t>();
   for (auto ix = 0; ix < array.ndim(); ++ix) {
-    ss << array.shape(ix) << ", ";
+    shape.push_back(array.shape(ix));
   }
-  ss << ")";
-  return ss.str();
+  return shape_string(shape);
 }
 
 /// Automation of vector size control to ensure that all vectors have the same
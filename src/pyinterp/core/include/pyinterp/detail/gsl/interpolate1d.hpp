@@ -7,6 +7,7 @@
 #include <Eigen/Core>
 #include <functional>
 #include <memory>
+#include <tuple>
 #include "pyinterp/detail/broadcast.hpp"
 #include "pyinterp/detail/gsl/accelerator.hpp"
 
@@ -37,6 +38,19 @@ class Interpolate1D {
     return gsl_interp_min_size(workspace_.get());
   }
 
+  /// Fits the function on the points provided, to be evaluated by
+  /// `evaluate` as long as the points are unchanged.
+  inline auto fit(const Eigen::VectorXd& xa, const Eigen::VectorXd& ya)
+      -> void {
+    init(xa, ya);
+  }
+
+  /// Return the value of the function fitted by `fit` for a given point x
+  inline auto evaluate(const Eigen::VectorXd& xa, const Eigen::VectorXd& ya,
+                       const double x) -> double {
+    return gsl_interp_eval(workspace_.get(), xa.data(), ya.data(), x, acc_);
+  }
+
   /// Return the interpolated value of y for a given point x
   inline auto interpolate(const Eigen::VectorXd& xa, const Eigen::VectorXd& ya,
                           const double x) -> double {
@@ -52,6 +66,20 @@ class Interpolate1D {
                                  acc_);
   }
 
+  /// Return the interpolated value of y and the derivative d of the
+  /// interpolated function for a given point x, fitting the function only
+  /// once.
+  inline auto interpolate_and_derivative(const Eigen::VectorXd& xa,
+                                         const Eigen::VectorXd& ya,
+                                         const double x)
+      -> std::tuple<double, double> {
+    init(xa, ya);
+    return std::make_tuple(
+        gsl_interp_eval(workspace_.get(), xa.data(), ya.data(), x, acc_),
+        gsl_interp_eval_deriv(workspace_.get(), xa.data(), ya.data(), x,
+                              acc_));
+  }
+
   /// Return the second derivative d of an interpolated function for a given
   /// point x
   inline auto second_derivative(const Eigen::VectorXd& xa,
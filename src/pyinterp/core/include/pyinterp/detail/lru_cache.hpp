@@ -0,0 +1,115 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace pyinterp::detail {
+
+/// Bounded cache keeping the most recently used values, shared between
+/// threads.
+///
+/// @tparam Key Key identifying the values
+/// @tparam Value Values cached
+/// @tparam Hash Hash function of the keys
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+ public:
+  /// Creates a new cache
+  ///
+  /// @param capacity Maximum number of values kept
+  explicit LruCache(const size_t capacity) : capacity_(capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("the capacity must not be zero");
+    }
+  }
+
+  /// Gets the value associated with the key, counting a hit or a miss. The
+  /// value found becomes the most recently used.
+  auto find(const Key& key) -> std::optional<Value> {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return {};
+    }
+    ++hits_;
+    items_.splice(items_.begin(), items_, it->second);
+    return it->second->second;
+  }
+
+  /// Associates a value with the key, as the most recently used value. The
+  /// least recently used value is dropped if the cache is full.
+  auto insert(const Key& key, const Value& value) -> void {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = value;
+      items_.splice(items_.begin(), items_, it->second);
+      return;
+    }
+    if (items_.size() == capacity_) {
+      index_.erase(items_.back().first);
+      items_.pop_back();
+    }
+    items_.emplace_front(key, value);
+    index_.emplace(key, items_.begin());
+  }
+
+  /// Drops the values and resets the counters.
+  auto clear() -> void {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    index_.clear();
+    items_.clear();
+    hits_ = misses_ = 0;
+  }
+
+  /// Gets the maximum number of values kept
+  [[nodiscard]] inline auto capacity() const noexcept -> size_t {
+    return capacity_;
+  }
+
+  /// Gets the number of values kept
+  [[nodiscard]] auto size() const -> size_t {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    return items_.size();
+  }
+
+  /// Gets the number of values found by find
+  [[nodiscard]] auto hits() const -> uint64_t {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    return hits_;
+  }
+
+  /// Gets the number of values not found by find
+  [[nodiscard]] auto misses() const -> uint64_t {
+    auto lock = std::lock_guard<std::mutex>(mutex_);
+    return misses_;
+  }
+
+ private:
+  using Items = std::list<std::pair<Key, Value>>;
+
+  /// Maximum number of values kept
+  size_t capacity_;
+  /// Values, from the most to the least recently used
+  Items items_{};
+  /// Position of the values in the list
+  std::unordered_map<Key, typename Items::iterator, Hash> index_{};
+  /// Number of values found
+  uint64_t hits_{0};
+  /// Number of values not found
+  uint64_t misses_{0};
+  /// Protects the access to the cache
+  mutable std::mutex mutex_{};
+};
+
+}  // namespace pyinterp::detail
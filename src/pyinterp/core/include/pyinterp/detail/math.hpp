@@ -200,6 +200,26 @@ inline constexpr auto sqr(const T& x) noexcept -> T {
   return x * x;
 }
 
+/// Raises a number to an integer power, by successive squaring, which is much
+/// faster than std::pow.
+///
+/// @return \f$x^n\f$
+template <typename T>
+inline constexpr auto ipow(T x, int n) noexcept -> T {
+  if (n < 0) {
+    return T(1) / ipow(x, -n);
+  }
+  auto result = T(1);
+  while (n != 0) {
+    if ((n & 1) != 0) {
+      result *= x;
+    }
+    x *= x;
+    n >>= 1;
+  }
+  return result;
+}
+
 /// True if a is almost zero to epsilon
 template <typename T>
 inline constexpr auto is_almost_zero(const T& a, const T& epsilon) noexcept
@@ -4,8 +4,13 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <Eigen/Core>
+#include <array>
+#include <optional>
+#include <tuple>
+#include <vector>
 #include "pyinterp/detail/gsl/interpolate1d.hpp"
 #include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/math/linear.hpp"
 
 namespace pyinterp::detail::math {
 
@@ -107,6 +112,48 @@ class CoordsXY {
   std::shared_ptr<Eigen::VectorXd> y_{};
 };
 
+/// Read-only view of the coordinates/values of a 2D window, which does not
+/// own the memory it refers to: used to interpolate the layers of a 3D or 4D
+/// frame without copying the shared pointers of the frame.
+class XArray2DView {
+ public:
+  /// Creates a new view
+  ///
+  /// @param x x-coordinates
+  /// @param y y-coordinates
+  /// @param data first value of the window, stored in column-major order
+  XArray2DView(const Eigen::VectorXd *x, const Eigen::VectorXd *y,
+               const double *data) noexcept
+      : x_(x), y_(y), data_(data) {}
+
+  /// Get x-coordinates
+  [[nodiscard]] inline auto x() const noexcept -> const Eigen::VectorXd * {
+    return x_;
+  }
+
+  /// Get y-coordinates
+  [[nodiscard]] inline auto y() const noexcept -> const Eigen::VectorXd * {
+    return y_;
+  }
+
+  /// Get the values from the array for all x and y coordinates.
+  [[nodiscard]] inline auto q() const noexcept
+      -> Eigen::Map<const Eigen::MatrixXd> {
+    return {data_, x_->size(), y_->size()};
+  }
+
+  /// Get the value at coordinate (ix, jx).
+  [[nodiscard]] inline auto q(const size_t ix, const size_t jx) const
+      -> double {
+    return data_[ix + jx * x_->size()];
+  }
+
+ private:
+  const Eigen::VectorXd *x_;
+  const Eigen::VectorXd *y_;
+  const double *data_;
+};
+
 /// Set of coordinates/values used for interpolation
 ///  * q11 = (x1, y1)
 ///  * q12 = (x1, y2)
@@ -123,6 +170,9 @@ class CoordsXY {
 /// Array2D({{x1, x2, ..., xn}, {y1, y2, ..., yn}},
 ///         {q11, q12, ..., q21, q22, ...., qnn})
 /// @endcode
+///
+/// The values are stored in column-major order in a buffer which can be
+/// shared with the other layers of a 3D or 4D frame.
 class XArray2D : public CoordsXY {
  public:
   /// Default constructor
@@ -130,15 +180,19 @@ class XArray2D : public CoordsXY {
 
   /// Creates a new Array
   XArray2D(const size_t x_size, const size_t y_size)
-      : CoordsXY(x_size, y_size), q_(new Eigen::MatrixXd) {
-    q_->resize(x()->size(), y()->size());
-  }
+      : CoordsXY(x_size, y_size),
+        storage_(std::make_shared<Eigen::MatrixXd>(x()->size(), y()->size())),
+        data_(storage_->data()) {}
 
-  /// Creates a new Array from existing coordinates/values
+  /// Creates a new Array from existing coordinates, whose values are stored
+  /// in the buffer provided from the given offset
   XArray2D(std::shared_ptr<Eigen::VectorXd> x,
            std::shared_ptr<Eigen::VectorXd> y,
-           std::shared_ptr<Eigen::MatrixXd> q)
-      : CoordsXY(std::move(x), std::move(y)), q_(std::move(q)) {}
+           std::shared_ptr<Eigen::MatrixXd> storage,
+           const Eigen::Index offset = 0)
+      : CoordsXY(std::move(x), std::move(y)),
+        storage_(std::move(storage)),
+        data_(storage_->data() + offset) {}
 
   /// Default destructor
   ~XArray2D() override = default;
@@ -164,31 +218,42 @@ class XArray2D : public CoordsXY {
   auto operator=(XArray2D &&rhs) noexcept -> XArray2D & = default;
 
   /// Get the values from the array for all x and y coordinates.
-  inline auto q() noexcept -> std::shared_ptr<Eigen::MatrixXd> & { return q_; }
+  inline auto q() noexcept -> Eigen::Map<Eigen::MatrixXd> {
+    return {data_, x()->size(), y()->size()};
+  }
 
   /// Get the values from the array for all x and y coordinates.
   [[nodiscard]] inline auto q() const noexcept
-      -> const std::shared_ptr<Eigen::MatrixXd> & {
-    return q_;
+      -> Eigen::Map<const Eigen::MatrixXd> {
+    return {data_, x()->size(), y()->size()};
   }
 
   /// Get the value at coordinate (ix, jx).
   [[nodiscard]] inline auto q(const size_t ix, const size_t jx) const
       -> double {
-    return (*q_)(ix, jx);
+    return data_[ix + jx * x()->size()];
   }
 
   /// Get the value at coordinate (ix, jx).
   inline auto q(const size_t ix, const size_t jx) -> double & {
-    return (*q_)(ix, jx);
+    return data_[ix + jx * x()->size()];
   }
 
   /// Returns true if this instance does not contains at least one Not A Number
   /// (NaN).
-  [[nodiscard]] inline auto is_valid() const -> bool { return !q_->hasNaN(); }
+  [[nodiscard]] inline auto is_valid() const -> bool { return !q().hasNaN(); }
+
+  /// Get a read-only view of this array
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  inline operator XArray2DView() const noexcept {
+    return {x().get(), y().get(), data_};
+  }
 
  private:
-  std::shared_ptr<Eigen::MatrixXd> q_{};
+  /// Buffer holding the values
+  std::shared_ptr<Eigen::MatrixXd> storage_{};
+  /// First value of this array in the buffer
+  double *data_{nullptr};
 };
 
 /// Set of coordinates/values used for 3D-interpolation
@@ -205,16 +270,13 @@ class XArray3D : public CoordsXY {
       : CoordsXY(x_size, y_size), z_(), q_() {
     auto nz = z_size << 1U;
     z_.resize(nz);
-    q_.resize(nz);
-
-    for (auto iz = 0U; iz < nz; ++iz) {
-      q_(iz) = std::make_shared<Eigen::MatrixXd>(x()->size(), y()->size());
-    }
+    q_ = std::make_shared<Eigen::MatrixXd>(x()->size(), y()->size() * nz);
   }
 
   /// Get the set of coordinates/values for the ith z-layer
-  [[nodiscard]] auto xarray_2d(const Eigen::Index iz) const -> XArray2D {
-    return XArray2D(x(), y(), q_(iz));
+  [[nodiscard]] auto xarray_2d(const Eigen::Index iz) const -> XArray2DView {
+    return {x().get(), y().get(),
+            q_->data() + iz * x()->size() * y()->size()};
   }
 
   /// Default destructor
@@ -264,23 +326,17 @@ class XArray3D : public CoordsXY {
 
   /// Get the value at coordinate (ix, jx, kx).
   inline auto q(const size_t ix, const size_t jx, const size_t kx) -> double & {
-    return (*q_(kx))(ix, jx);
+    return (*q_)(ix, kx * y()->size() + jx);
   }
 
   /// Returns true if this instance does not contains at least one Not A Number
   /// (NaN).
-  [[nodiscard]] inline auto is_valid() const -> bool {
-    for (Eigen::Index kx = 0; kx < q_.size(); ++kx) {
-      if ((*q_(kx)).hasNaN()) {
-        return false;
-      }
-    }
-    return true;
-  }
+  [[nodiscard]] inline auto is_valid() const -> bool { return !q_->hasNaN(); }
 
  private:
   Eigen::Matrix<T, Eigen::Dynamic, 1> z_;
-  Eigen::Matrix<std::shared_ptr<Eigen::MatrixXd>, Eigen::Dynamic, 1> q_;
+  /// Values of the layers, stored one after the other
+  std::shared_ptr<Eigen::MatrixXd> q_;
 };
 
 /// Set of coordinates/values used for 4D-interpolation
@@ -300,20 +356,15 @@ class XArray4D : public CoordsXY {
     auto nu = u_size << 1U;
     z_.resize(nz);
     u_.resize(nu);
-    q_.resize(nz, nu);
-
-    for (auto iz = 0U; iz < nz; ++iz) {
-      for (auto iu = 0U; iu < nu; ++iu) {
-        q_(iz, iu) =
-            std::make_shared<Eigen::MatrixXd>(x()->size(), y()->size());
-      }
-    }
+    q_ = std::make_shared<Eigen::MatrixXd>(x()->size(),
+                                           y()->size() * nz * nu);
   }
 
   /// Get the set of coordinates/values for the ith z-layer
   [[nodiscard]] auto xarray_2d(const Eigen::Index iz,
-                               const Eigen::Index iu) const -> XArray2D {
-    return XArray2D(x(), y(), q_(iz, iu));
+                               const Eigen::Index iu) const -> XArray2DView {
+    return {x().get(), y().get(),
+            q_->data() + layer(iz, iu) * x()->size() * y()->size()};
   }
 
   /// Default destructor
@@ -385,28 +436,26 @@ class XArray4D : public CoordsXY {
   /// Get the value at coordinate (ix, jx, kx).
   inline auto q(const size_t ix, const size_t jx, const size_t kx,
                 const size_t lx) -> double & {
-    return (*q_(kx, lx))(ix, jx);
+    return (*q_)(ix, layer(kx, lx) * y()->size() + jx);
   }
 
   /// Returns true if this instance does not contains at least one Not A Number
   /// (NaN).
-  [[nodiscard]] inline auto is_valid() const -> bool {
-    for (Eigen::Index kx = 0; kx < z_.size(); ++kx) {
-      for (Eigen::Index lx = 0; lx < u_.size(); ++lx) {
-        if ((*q_(kx, lx)).hasNaN()) {
-          return false;
-        }
-      }
-    }
-    return true;
-  }
+  [[nodiscard]] inline auto is_valid() const -> bool { return !q_->hasNaN(); }
 
  private:
   Eigen::Matrix<T, Eigen::Dynamic, 1> z_;
   Eigen::VectorXd u_;
-  Eigen::Matrix<std::shared_ptr<Eigen::MatrixXd>, Eigen::Dynamic,
-                Eigen::Dynamic>
-      q_;
+  /// Values of the layers, stored one after the other: the layers of a
+  /// U-coordinate are contiguous.
+  std::shared_ptr<Eigen::MatrixXd> q_;
+
+  /// Get the position of the layer (kx, lx) in the buffer
+  [[nodiscard]] inline auto layer(const Eigen::Index kx,
+                                  const Eigen::Index lx) const
+      -> Eigen::Index {
+    return lx * z_.size() + kx;
+  }
 };
 
 /// Extension of cubic interpolation for interpolating data points on a
@@ -419,50 +468,157 @@ class Bicubic {
   ///
   /// @param xr Calculation window.
   /// @param type method of calculation
-  explicit Bicubic(const XArray2D &xr, const gsl_interp_type *type)
-      : column_(xr.x()->size()),
+  explicit Bicubic(const XArray2DView &xr, const gsl_interp_type *type)
+      : type_(type),
+        column_(xr.x()->size()),
+        dy_column_(xr.x()->size()),
         interpolator_(std::max(xr.x()->size(), xr.y()->size()), type,
                       gsl::Accelerator()) {}
 
   /// Return the interpolated value of y for a given point x
-  auto interpolate(const double x, const double y, const XArray2D &xr)
+  auto interpolate(const double x, const double y, const XArray2DView &xr)
       -> double {
     return evaluate(&gsl::Interpolate1D::interpolate, x, y, xr);
   }
 
+  /// Return the interpolated value of y for a given point x, keeping the
+  /// splines fitted on the rows of the window: if refit is false, the window
+  /// is the one of the previous call and only the spline along X is fitted.
+  auto interpolate(const double x, const double y, const XArray2DView &xr,
+                   const bool refit) -> double {
+    if (refit || rows_.empty()) {
+      fit_rows(xr);
+    }
+    for (Eigen::Index ix = 0; ix < xr.x()->size(); ++ix) {
+      column_(ix) = rows_[ix].evaluate(*(xr.y()), values_[ix], y);
+    }
+    return interpolator_.interpolate(*(xr.x()), column_, x);
+  }
+
   /// Return the derivative for a given point x
-  auto derivative(const double x, const double y, const XArray2D &xr)
+  auto derivative(const double x, const double y, const XArray2DView &xr)
       -> double {
     return evaluate(&gsl::Interpolate1D::derivative, x, y, xr);
   }
 
   /// Return the second derivative for a given point x
-  auto second_derivative(const double x, const double y, const XArray2D &xr)
+  auto second_derivative(const double x, const double y, const XArray2DView &xr)
       -> double {
     return evaluate(&gsl::Interpolate1D::second_derivative, x, y, xr);
   }
 
+  /// Return the interpolated value and the partial derivatives of the
+  /// interpolated surface for a given point: f, df/dx, df/dy and d²f/dxdy.
+  /// Each spline is fitted once for the four quantities.
+  auto gradient(const double x, const double y, const XArray2DView &xr)
+      -> std::array<double, 4> {
+    // Spline interpolation as function of Y-coordinate, and its derivative
+    for (Eigen::Index ix = 0; ix < xr.x()->size(); ++ix) {
+      std::tie(column_(ix), dy_column_(ix)) =
+          interpolator_.interpolate_and_derivative(*(xr.y()), xr.q().row(ix),
+                                                   y);
+    }
+    auto result = std::array<double, 4>();
+    std::tie(result[0], result[1]) =
+        interpolator_.interpolate_and_derivative(*(xr.x()), column_, x);
+    std::tie(result[2], result[3]) =
+        interpolator_.interpolate_and_derivative(*(xr.x()), dy_column_, x);
+    return result;
+  }
+
  private:
   using InterpolateFunction = double (gsl::Interpolate1D::*)(
       const Eigen::VectorXd &, const Eigen::VectorXd &, const double);
+  /// Fitting model
+  const gsl_interp_type *type_;
   /// Column of the interpolation window (interpolation according to Y
   /// coordinates)
   Eigen::VectorXd column_;
+  /// Derivatives of the splines fitted on the columns of the window
+  Eigen::VectorXd dy_column_;
   /// GSL interpolator
   gsl::Interpolate1D interpolator_;
+  /// Splines fitted along Y on the rows of the window
+  std::vector<gsl::Interpolate1D> rows_{};
+  /// Values of the rows of the window on which the splines are fitted
+  std::vector<Eigen::VectorXd> values_{};
+
+  /// Fits the splines along Y on the rows of the window.
+  auto fit_rows(const XArray2DView &xr) -> void {
+    const auto nx = static_cast<size_t>(xr.x()->size());
+    while (rows_.size() < nx) {
+      rows_.emplace_back(std::max(xr.x()->size(), xr.y()->size()), type_,
+                         gsl::Accelerator());
+    }
+    values_.resize(nx);
+    for (size_t ix = 0; ix < nx; ++ix) {
+      values_[ix] = xr.q().row(static_cast<Eigen::Index>(ix)).transpose();
+      rows_[ix].fit(*(xr.y()), values_[ix]);
+    }
+  }
 
   /// Evaluation of the GSL function performing the calculation.
   auto evaluate(
       const std::function<double(gsl::Interpolate1D &, const Eigen::VectorXd &,
                                  const Eigen::VectorXd &, const double)>
           &function,
-      const double x, const double y, const XArray2D &xr) -> double {
+      const double x, const double y, const XArray2DView &xr) -> double {
     // Spline interpolation as function of Y-coordinate
     for (Eigen::Index ix = 0; ix < xr.x()->size(); ++ix) {
-      column_(ix) = function(interpolator_, *(xr.y()), xr.q()->row(ix), y);
+      column_(ix) = function(interpolator_, *(xr.y()), xr.q().row(ix), y);
     }
     return function(interpolator_, *(xr.x()), column_, x);
   }
 };
 
+/// Interpolation, along the Z or U axis of a window, of the values
+/// interpolated on its layers: linear between the two layers of a window of
+/// half size 1, or with a spline fitted on the layers of larger windows.
+///
+/// @tparam T Axis type
+template <typename T>
+class LayerInterpolator {
+ public:
+  /// Default constructor
+  ///
+  /// @param size Half size of the window along the axis.
+  /// @param type method of calculation of the spline
+  LayerInterpolator(const size_t size, const gsl_interp_type *type)
+      : xa_(size << 1U), values_(size << 1U) {
+    if (size > 1) {
+      interpolator_.emplace(size << 1U, type, gsl::Accelerator());
+    }
+  }
+
+  /// Get the values interpolated on the layers of the window
+  inline auto values() noexcept -> Eigen::VectorXd & { return values_; }
+
+  /// Return the value interpolated at the coordinate provided.
+  ///
+  /// @param axis Coordinates of the layers of the window
+  /// @param coordinate Coordinate of the point to interpolate
+  auto interpolate(const Eigen::Matrix<T, Eigen::Dynamic, 1> &axis,
+                   const T coordinate) -> double {
+    if (!interpolator_.has_value()) {
+      return linear<T, double>(coordinate, axis(0), axis(1), values_(0),
+                               values_(1));
+    }
+    // The coordinates are expressed relative to the first layer so that the
+    // dates are not rounded when converted to double.
+    for (Eigen::Index ix = 0; ix < axis.size(); ++ix) {
+      xa_(ix) = static_cast<double>(axis(ix) - axis(0));
+    }
+    return interpolator_->interpolate(
+        xa_, values_, static_cast<double>(coordinate - axis(0)));
+  }
+
+ private:
+  /// Coordinates of the layers, relative to the first one
+  Eigen::VectorXd xa_;
+  /// Values interpolated on the layers
+  Eigen::VectorXd values_;
+  /// GSL interpolator, reused for all the points interpolated
+  std::optional<gsl::Interpolate1D> interpolator_{};
+};
+
 }  // namespace pyinterp::detail::math
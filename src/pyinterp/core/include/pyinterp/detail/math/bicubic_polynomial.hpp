@@ -0,0 +1,63 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace pyinterp::detail::math {
+
+/// Positions, in a cell, of the samples defining a bicubic polynomial.
+constexpr std::array<double, 4> kBicubicSamples = {0.0, 1.0 / 3.0, 2.0 / 3.0,
+                                                   1.0};
+
+/// Coefficients of the bicubic polynomial p(t, u) = Σ a[m * 4 + n] tᵐ uⁿ
+/// taking the values provided at the samples of a cell.
+///
+/// @param f Values of the polynomial, f[ix * 4 + jx] holding the value at
+/// (kBicubicSamples[ix], kBicubicSamples[jx])
+/// @return the coefficients a of the polynomial
+inline constexpr auto bicubic_polynomial(const std::array<double, 16>& f)
+    -> std::array<double, 16> {
+  // Inverse of the Vandermonde matrix of the samples
+  constexpr std::array<double, 16> inverse = {
+      1.0,  0.0,   0.0,   0.0,  -5.5, 9.0,   -4.5,  1.0,
+      9.0,  -22.5, 18.0,  -4.5, -4.5, 13.5,  -13.5, 4.5};
+  auto g = std::array<double, 16>();
+  for (size_t mx = 0; mx < 4; ++mx) {
+    for (size_t jx = 0; jx < 4; ++jx) {
+      for (size_t ix = 0; ix < 4; ++ix) {
+        g[mx * 4 + jx] += inverse[mx * 4 + ix] * f[ix * 4 + jx];
+      }
+    }
+  }
+  auto a = std::array<double, 16>();
+  for (size_t mx = 0; mx < 4; ++mx) {
+    for (size_t nx = 0; nx < 4; ++nx) {
+      for (size_t jx = 0; jx < 4; ++jx) {
+        a[mx * 4 + nx] += g[mx * 4 + jx] * inverse[nx * 4 + jx];
+      }
+    }
+  }
+  return a;
+}
+
+/// Evaluates a bicubic polynomial.
+///
+/// @param a Coefficients of the polynomial, computed by bicubic_polynomial
+/// @param t Position of the point in the cell along the first axis
+/// @param u Position of the point in the cell along the second axis
+/// @return the value of the polynomial
+inline constexpr auto evaluate_bicubic_polynomial(
+    const std::array<double, 16>& a, const double t, const double u)
+    -> double {
+  auto result = 0.0;
+  for (size_t mx = 4; mx-- > 0;) {
+    const auto* row = &a[mx * 4];
+    result = result * t + (((row[3] * u + row[2]) * u + row[1]) * u + row[0]);
+  }
+  return result;
+}
+
+}  // namespace pyinterp::detail::math
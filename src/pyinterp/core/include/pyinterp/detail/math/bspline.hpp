@@ -0,0 +1,141 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace pyinterp::detail::math {
+
+/// Weights of the cubic B-spline for the four coefficients c₋₁, c₀, c₁, c₂
+/// of a regular axis surrounding the point x₀ + t (x₁ - x₀).
+///
+/// @param t Position of the point in the cell [x₀, x₁], between 0 and 1
+/// @return the weights of the coefficients c₋₁, c₀, c₁ and c₂
+inline constexpr auto bspline_weights(const double t)
+    -> std::array<double, 4> {
+  const auto u = 1.0 - t;
+  const auto t3 = t * t * t;
+  return {u * u * u / 6.0, (3.0 * t3 - 6.0 * t * t + 4.0) / 6.0,
+          (-3.0 * t3 + 3.0 * t * t + 3.0 * t + 1.0) / 6.0, t3 / 6.0};
+}
+
+namespace bspline {
+
+/// Pole of the recursive filter computing the coefficients of the cubic
+/// B-spline: √3 - 2
+constexpr double kPole = -0.267949192431122706472553658494127633;
+
+/// Computes in place the coefficients of the cubic B-spline interpolating
+/// the n values provided, extended by mirror symmetry at both ends.
+inline auto mirror(double* c, const Eigen::Index n) -> void {
+  if (n < 2) {
+    return;
+  }
+  for (Eigen::Index ix = 0; ix < n; ++ix) {
+    c[ix] *= 6.0;
+  }
+
+  // Causal filter, initialized on the values mirrored at the beginning.
+  auto zn = kPole;
+  auto z2n = std::pow(kPole, static_cast<double>(n - 1));
+  auto sum = c[0] + z2n * c[n - 1];
+  z2n *= z2n / kPole;
+  for (Eigen::Index ix = 1; ix < n - 1; ++ix) {
+    sum += (zn + z2n) * c[ix];
+    zn *= kPole;
+    z2n /= kPole;
+  }
+  c[0] = sum / (1.0 - zn * zn);
+  for (Eigen::Index ix = 1; ix < n; ++ix) {
+    c[ix] += kPole * c[ix - 1];
+  }
+
+  // Anticausal filter, initialized on the values mirrored at the end.
+  c[n - 1] = (kPole / (kPole * kPole - 1.0)) * (kPole * c[n - 2] + c[n - 1]);
+  for (auto ix = n - 2; ix >= 0; --ix) {
+    c[ix] = kPole * (c[ix + 1] - c[ix]);
+  }
+}
+
+/// Computes in place the coefficients of the cubic B-spline interpolating
+/// the n values provided, repeated periodically.
+inline auto periodic(double* c, const Eigen::Index n) -> void {
+  if (n < 2) {
+    return;
+  }
+  for (Eigen::Index ix = 0; ix < n; ++ix) {
+    c[ix] *= 6.0;
+  }
+  const auto zn = std::pow(kPole, static_cast<double>(n));
+
+  // Causal filter, initialized on the previous periods.
+  auto zk = kPole;
+  auto sum = c[0];
+  for (Eigen::Index ix = 1; ix < n; ++ix) {
+    sum += zk * c[n - ix];
+    zk *= kPole;
+  }
+  c[0] = sum / (1.0 - zn);
+  for (Eigen::Index ix = 1; ix < n; ++ix) {
+    c[ix] += kPole * c[ix - 1];
+  }
+
+  // Anticausal filter, initialized on the next periods.
+  zk = 1.0;
+  sum = 0.0;
+  for (Eigen::Index ix = 0; ix < n; ++ix) {
+    sum += zk * c[(n - 1 + ix) % n];
+    zk *= kPole;
+  }
+  c[n - 1] = -kPole / (1.0 - zn) * sum;
+  for (auto ix = n - 2; ix >= 0; --ix) {
+    c[ix] = kPole * (c[ix + 1] - c[ix]);
+  }
+}
+
+}  // namespace bspline
+
+/// Computes in place the coefficients of the cubic B-spline interpolating
+/// the values of a regular axis.
+///
+/// The undefined values split the line into independent segments, extended
+/// by mirror symmetry at their ends: the coefficients of a segment do not
+/// depend on the values beyond the undefined values framing it, which are
+/// kept undefined.
+///
+/// @param line Values of the axis, replaced by the coefficients
+/// @param periodic True if the axis is a circle: the values are repeated
+/// periodically if the line is fully defined.
+inline auto bspline_prefilter(Eigen::Ref<Eigen::VectorXd> line,
+                              const bool periodic) -> void {
+  const auto n = line.size();
+  auto* data = line.data();
+  auto first_nan =
+      std::find_if(data, data + n, [](auto item) { return std::isnan(item); });
+  if (first_nan == data + n) {
+    periodic ? bspline::periodic(data, n) : bspline::mirror(data, n);
+    return;
+  }
+
+  // The segment crossing the end of a periodic line is made contiguous by
+  // starting the line after an undefined value.
+  const auto shift = periodic ? (first_nan - data) + 1 : 0;
+  std::rotate(data, data + shift, data + n);
+
+  auto begin = data;
+  while (begin != data + n) {
+    begin = std::find_if(begin, data + n,
+                         [](auto item) { return !std::isnan(item); });
+    auto end = std::find_if(begin, data + n,
+                            [](auto item) { return std::isnan(item); });
+    bspline::mirror(begin, end - begin);
+    begin = end;
+  }
+  std::rotate(data, data + n - shift, data + n);
+}
+
+}  // namespace pyinterp::detail::math
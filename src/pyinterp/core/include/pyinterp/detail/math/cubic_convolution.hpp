@@ -0,0 +1,44 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace pyinterp::detail::math {
+
+/// Weights of the cubic convolution kernel of Keys (a = -1/2, also known as
+/// the Catmull-Rom spline) for the four nodes x₋₁, x₀, x₁, x₂ of a regular
+/// axis surrounding the point x₀ + t (x₁ - x₀).
+///
+/// @param t Position of the point in the cell [x₀, x₁], between 0 and 1
+/// @return the weights of the nodes x₋₁, x₀, x₁ and x₂
+inline constexpr auto cubic_convolution_weights(const double t)
+    -> std::array<double, 4> {
+  return {((-0.5 * t + 1.0) * t - 0.5) * t, (1.5 * t - 2.5) * t * t + 1.0,
+          ((-1.5 * t + 2.0) * t + 0.5) * t, (0.5 * t - 0.5) * t * t};
+}
+
+/// Convolution of the 4×4 values surrounding a point of a regular grid.
+///
+/// @param q Values of the grid, q[ix * 4 + jx] holding the value of the node
+/// (x_ix, y_jx)
+/// @param wx Weights of the kernel along X
+/// @param wy Weights of the kernel along Y
+/// @return the value interpolated, NaN if one of the values is undefined
+inline constexpr auto convolve(const std::array<double, 16>& q,
+                               const std::array<double, 4>& wx,
+                               const std::array<double, 4>& wy) -> double {
+  auto result = 0.0;
+  for (size_t ix = 0; ix < 4; ++ix) {
+    auto column = 0.0;
+    for (size_t jx = 0; jx < 4; ++jx) {
+      column += wy[jx] * q[ix * 4 + jx];
+    }
+    result += wx[ix] * column;
+  }
+  return result;
+}
+
+}  // namespace pyinterp::detail::math
@@ -0,0 +1,152 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "pyinterp/detail/axis.hpp"
+
+namespace pyinterp::detail::math {
+
+/// Bilinear interpolation of a grid whose both axes are evenly spaced.
+///
+/// The cells containing the query points and the interpolation weights are
+/// calculated with arithmetic operations only, without searching the axes,
+/// for blocks of points processed by loops without branches that the
+/// compiler can vectorize. The values of the four points of the cells are
+/// then gathered and combined as done by Bilinear::evaluate. The positions
+/// of the points in the cells are calculated from the first value and the
+/// step of the axes instead of the values of the axes: the results differ
+/// from those of the generic path by a relative error of the order of 1e-12.
+///
+/// @tparam T Type of the coordinates and of the interpolated values.
+template <typename T>
+class RegularBilinear {
+ public:
+  /// Number of points processed by block
+  static constexpr size_t kBlockSize = 256;
+
+  /// Default constructor
+  ///
+  /// @param x X-Axis of the grid
+  /// @param y Y-Axis of the grid
+  RegularBilinear(const Axis<double>& x, const Axis<double>& y)
+      : x_(x), y_(y) {}
+
+  /// Test if the fast path can be used to interpolate a grid defined by the
+  /// given axes. The circles sorted in descending order are not handled:
+  /// Axis::find_indexes frames the points located between the last and the
+  /// first value of these axes in a specific way.
+  static auto is_suitable(const Axis<double>& x, const Axis<double>& y)
+      -> bool {
+    return x.is_regular() && y.is_regular() && x.size() > 1 &&
+           y.size() > 1 && (!x.is_circle() || x.is_ascending());
+  }
+
+  /// Interpolates a block of points. The values of the points located
+  /// outside the grid are set to NaN.
+  ///
+  /// @param x X-coordinates of the points
+  /// @param y Y-coordinates of the points
+  /// @param size Number of points to process, at most kBlockSize
+  /// @param value Function returning the value of the grid at the indexes
+  /// (ix, iy)
+  /// @param result Interpolated values
+  template <typename Function>
+  void evaluate(const T* x, const T* y, const size_t size,
+                const Function& value, T* result) const {
+    auto ix0 = std::array<int64_t, kBlockSize>();
+    auto ix1 = std::array<int64_t, kBlockSize>();
+    auto iy0 = std::array<int64_t, kBlockSize>();
+    auto iy1 = std::array<int64_t, kBlockSize>();
+    auto t = std::array<T, kBlockSize>();
+    auto u = std::array<T, kBlockSize>();
+
+    x_.locate(x, size, ix0.data(), ix1.data(), t.data());
+    y_.locate(y, size, iy0.data(), iy1.data(), u.data());
+
+    for (size_t ix = 0; ix < size; ++ix) {
+      auto q00 = static_cast<T>(value(ix0[ix], iy0[ix]));
+      auto q01 = static_cast<T>(value(ix0[ix], iy1[ix]));
+      auto q10 = static_cast<T>(value(ix1[ix], iy0[ix]));
+      auto q11 = static_cast<T>(value(ix1[ix], iy1[ix]));
+      result[ix] = (T(1) - t[ix]) * (T(1) - u[ix]) * q00 +
+                   t[ix] * (T(1) - u[ix]) * q10 +
+                   (T(1) - t[ix]) * u[ix] * q01 + t[ix] * u[ix] * q11;
+    }
+  }
+
+ private:
+  /// Properties of an axis used to locate the points
+  class Dimension {
+   public:
+    /// Default constructor
+    explicit Dimension(const Axis<double>& axis)
+        : min_(static_cast<T>(axis.min_value())),
+          max_(static_cast<T>(axis.max_value())),
+          step_(static_cast<T>(std::fabs(axis.increment()))),
+          inv_step_(T(1) / step_),
+          last_(axis.size() - 1),
+          is_ascending_(axis.is_ascending()),
+          is_angle_(axis.is_angle()),
+          is_circle_(axis.is_circle()) {}
+
+    /// Calculates the indexes of the cells containing the coordinates and
+    /// the position of the coordinates in the cells. The positions of the
+    /// coordinates located outside the axis are set to NaN.
+    void locate(const T* coordinates, const size_t size, int64_t* i0,
+                int64_t* i1, T* weight) const {
+      // Index of the last cell: on a circle the last point is connected to
+      // the first one.
+      const auto last_cell = static_cast<T>(is_circle_ ? last_ : last_ - 1);
+
+      for (size_t ix = 0; ix < size; ++ix) {
+        auto coordinate = coordinates[ix];
+        if (is_angle_) {
+          // Vectorized form of normalize_angle
+          coordinate -= T(360) * std::floor((coordinate - min_) / T(360));
+        }
+        auto position = (coordinate - min_) * inv_step_;
+        auto is_inside = is_circle_
+                             ? !std::isnan(position)
+                             : coordinate >= min_ && coordinate <= max_;
+
+        // The index is clamped to process the points located outside or
+        // NaN without branches.
+        auto cell = std::floor(position);
+        cell = cell > T(0) ? cell : T(0);
+        cell = cell < last_cell ? cell : last_cell;
+
+        auto x0 = min_ + cell * step_;
+        auto x1 = min_ + (cell + T(1)) * step_;
+        weight[ix] = is_inside ? (coordinate - x0) / (x1 - x0)
+                               : std::numeric_limits<T>::quiet_NaN();
+
+        // Indexes in the ascending order of the axis, and then in the order
+        // of the axis.
+        auto j0 = static_cast<int64_t>(cell);
+        auto j1 = j0 == last_ ? int64_t(0) : j0 + 1;
+        i0[ix] = is_ascending_ ? j0 : last_ - j0;
+        i1[ix] = is_ascending_ ? j1 : last_ - j1;
+      }
+    }
+
+   private:
+    T min_;
+    T max_;
+    T step_;
+    T inv_step_;
+    int64_t last_;
+    bool is_ascending_;
+    bool is_angle_;
+    bool is_circle_;
+  };
+
+  Dimension x_;
+  Dimension y_;
+};
+
+}  // namespace pyinterp::detail::math
@@ -65,6 +65,22 @@ constexpr auto get_z_interpolation_method(
   throw std::invalid_argument("unknown interpolation method: " + method);
 }
 
+/// Gets the coordinate of a point on the Z-Axis, as handled by the function
+/// interpolating along this axis.
+template <template <class> class Point = geometry::TemporalEquatorial2D,
+          typename T>
+inline auto z_coordinate(const geometry::TemporalEquatorial2D<T>& p)
+    -> int64_t {
+  return p.timestamp();
+}
+
+/// Gets the coordinate of a point on the Z-Axis, as handled by the function
+/// interpolating along this axis.
+template <template <class> class Point, typename T>
+inline auto z_coordinate(const Point<T>& p) -> T {
+  return boost::geometry::get<2>(p);
+}
+
 /// Performs the interpolation
 ///
 /// @param p Query point
@@ -122,4 +138,66 @@ inline auto trivariate(const Point<T>& p, const Point<T>& p0,
                       boost::geometry::get<2>(p1), z0, z1);
 }
 
+/// Performs the interpolation of several variables
+///
+/// @param p Query point
+/// @param p0 Point of coordinate (x0, y0, z0)
+/// @param p1 Point of coordinate (x1, y1, z1)
+/// @param q0 Matrix of shape (k, 4) containing, for each of the k variables,
+/// the values for the coordinates (x0, y0, z0), (x0, y1, z0), (x1, y0, z0)
+/// and (x1, y1, z0)
+/// @param q1 Values of the variables for the coordinate z1
+/// @param buffer Work vector of k elements
+/// @param result Vector of k elements receiving the interpolated values at
+/// coordinate (x, y, z)
+template <template <class> class Point = geometry::TemporalEquatorial2D,
+          typename T>
+inline void trivariate_variables(
+    const geometry::TemporalEquatorial2D<T>& p,
+    const geometry::TemporalEquatorial2D<T>& p0,
+    const geometry::TemporalEquatorial2D<T>& p1,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 4>>& q0,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 4>>& q1,
+    const Bivariate<geometry::TemporalEquatorial2D, T>* bivariate,
+    const z_method_t<int64_t, T>& interpolator,
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> buffer,
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> result) {
+  bivariate->evaluate_variables(p, p0, p1, q0, buffer);
+  bivariate->evaluate_variables(p, p0, p1, q1, result);
+  for (Eigen::Index ix = 0; ix < result.size(); ++ix) {
+    result(ix) = interpolator(p.timestamp(), p0.timestamp(), p1.timestamp(),
+                              buffer(ix), result(ix));
+  }
+}
+
+/// Performs the interpolation of several variables
+///
+/// @param p Query point
+/// @param p0 Point of coordinate (x0, y0, z0)
+/// @param p1 Point of coordinate (x1, y1, z1)
+/// @param q0 Matrix of shape (k, 4) containing, for each of the k variables,
+/// the values for the coordinates (x0, y0, z0), (x0, y1, z0), (x1, y0, z0)
+/// and (x1, y1, z0)
+/// @param q1 Values of the variables for the coordinate z1
+/// @param buffer Work vector of k elements
+/// @param result Vector of k elements receiving the interpolated values at
+/// coordinate (x, y, z)
+template <template <class> class Point, typename T>
+inline void trivariate_variables(
+    const Point<T>& p, const Point<T>& p0, const Point<T>& p1,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 4>>& q0,
+    const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, 4>>& q1,
+    const Bivariate<Point, T>* bivariate, const z_method_t<T, T>& interpolator,
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> buffer,
+    Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, 1>> result) {
+  bivariate->evaluate_variables(p, p0, p1, q0, buffer);
+  bivariate->evaluate_variables(p, p0, p1, q1, result);
+  for (Eigen::Index ix = 0; ix < result.size(); ++ix) {
+    result(ix) = interpolator(boost::geometry::get<2>(p),
+                              boost::geometry::get<2>(p0),
+                              boost::geometry::get<2>(p1), buffer(ix),
+                              result(ix));
+  }
+}
+
 }  // namespace pyinterp::detail::math
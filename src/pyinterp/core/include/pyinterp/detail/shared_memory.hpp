@@ -0,0 +1,106 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace pyinterp::detail {
+
+/// Named POSIX shared memory segment shared between processes.
+///
+/// The segment starts with a header storing the size of the user data and a
+/// reference counter incremented by each process attached to the segment.
+/// The segment is unlinked from the system when the last instance referencing
+/// it is destroyed. The user data are aligned on a cache line.
+class SharedMemory {
+ public:
+  /// Alignment of the user data
+  static constexpr size_t kAlignment = 64;
+
+  /// Creates a new segment
+  ///
+  /// @param name Name of the segment
+  /// @param size Size, in bytes, of the user data
+  /// @throw std::system_error if the segment cannot be created
+  static auto create(const std::string& name, size_t size) -> SharedMemory;
+
+  /// Attaches an existing segment
+  ///
+  /// @param name Name of the segment
+  /// @throw std::system_error if the segment cannot be opened
+  /// @throw std::runtime_error if the segment is not a valid segment or is
+  /// being destroyed
+  static auto attach(const std::string& name) -> SharedMemory;
+
+  /// Removes the segment name from the system, regardless of the processes
+  /// still attached to it. Useful to clean up the segments left by processes
+  /// that have been killed.
+  ///
+  /// @return true if the segment has been removed
+  static auto unlink(const std::string& name) -> bool;
+
+  /// Default destructor: detaches the segment and destroys it if this
+  /// instance is the last one referencing it
+  ~SharedMemory();
+
+  /// Copy constructor
+  SharedMemory(const SharedMemory&) = delete;
+
+  /// Move constructor
+  ///
+  /// @param rhs right value
+  SharedMemory(SharedMemory&& rhs) noexcept;
+
+  /// Copy assignment operator
+  auto operator=(const SharedMemory&) -> SharedMemory& = delete;
+
+  /// Move assignment operator
+  ///
+  /// @param rhs right value
+  auto operator=(SharedMemory&& rhs) noexcept -> SharedMemory&;
+
+  /// Gets the name of the segment
+  [[nodiscard]] inline auto name() const noexcept -> const std::string& {
+    return name_;
+  }
+
+  /// Gets the size of the user data
+  [[nodiscard]] auto size() const noexcept -> size_t;
+
+  /// Gets the number of instances, in all processes, attached to the segment
+  [[nodiscard]] auto ref_count() const noexcept -> int64_t;
+
+  /// Gets a pointer to the user data
+  [[nodiscard]] auto data() const noexcept -> void*;
+
+ private:
+  /// Header of the segment
+  struct Header {
+    std::atomic<uint64_t> magic;
+    uint64_t size;
+    std::atomic<int64_t> ref_count;
+  };
+
+  static_assert(sizeof(Header) <= kAlignment);
+  static_assert(std::atomic<int64_t>::is_always_lock_free,
+                "the reference counter must be lock free to be shared "
+                "between processes");
+
+  std::string name_{};
+  Header* header_{nullptr};
+  size_t length_{0};
+
+  /// Default constructor
+  SharedMemory(std::string name, Header* header, size_t length)
+      : name_(std::move(name)), header_(header), length_(length) {}
+
+  /// Detaches the segment
+  void release() noexcept;
+};
+
+}  // namespace pyinterp::detail
@@ -0,0 +1,203 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/thread.hpp"
+
+namespace pyinterp::detail {
+
+/// Inserts a zero bit between the 32 lower bits of an integer
+inline auto spread_bits(uint64_t value) noexcept -> uint64_t {
+  value &= 0x00000000ffffffffULL;
+  value = (value | (value << 16U)) & 0x0000ffff0000ffffULL;
+  value = (value | (value << 8U)) & 0x00ff00ff00ff00ffULL;
+  value = (value | (value << 4U)) & 0x0f0f0f0f0f0f0f0fULL;
+  value = (value | (value << 2U)) & 0x3333333333333333ULL;
+  value = (value | (value << 1U)) & 0x5555555555555555ULL;
+  return value;
+}
+
+/// Inserts two zero bits between the 21 lower bits of an integer
+inline auto spread_bits3(uint64_t value) noexcept -> uint64_t {
+  value &= 0x00000000001fffffULL;
+  value = (value | (value << 32U)) & 0x001f00000000ffffULL;
+  value = (value | (value << 16U)) & 0x001f0000ff0000ffULL;
+  value = (value | (value << 8U)) & 0x100f00f00f00f00fULL;
+  value = (value | (value << 4U)) & 0x10c30c30c30c30c3ULL;
+  value = (value | (value << 2U)) & 0x1249249249249249ULL;
+  return value;
+}
+
+/// Calculates the Morton code (Z-order curve) of a 2D position
+inline auto morton_key(const uint32_t x, const uint32_t y) noexcept
+    -> uint64_t {
+  return spread_bits(x) | (spread_bits(y) << 1U);
+}
+
+/// Calculates the Morton code (Z-order curve) of a 3D position (21 bits per
+/// coordinate)
+inline auto morton_key(const uint32_t x, const uint32_t y,
+                       const uint32_t z) noexcept -> uint64_t {
+  return spread_bits3(x) | (spread_bits3(y) << 1U) | (spread_bits3(z) << 2U);
+}
+
+/// Maps the coordinates of an axis onto integers preserving their order,
+/// without searching the axis: the points close on the axis get close
+/// integers.
+///
+/// @tparam T Type of data handled by the axis
+template <typename T>
+class AxisQuantizer {
+ public:
+  /// Default constructor
+  ///
+  /// @param axis Axis handling the coordinates
+  /// @param bits Number of bits of the integers calculated
+  AxisQuantizer(const Axis<T>& axis, const uint32_t bits)
+      : axis_(axis),
+        min_(static_cast<double>(axis.min_value())),
+        scale_(0),
+        max_index_(static_cast<double>((uint64_t(1) << bits) - 1)) {
+    auto range = axis.is_angle()
+                     ? 360.0
+                     : static_cast<double>(axis.max_value()) - min_;
+    if (range > 0) {
+      scale_ = max_index_ / range;
+    }
+  }
+
+  /// Returns the integer corresponding to the coordinate. The coordinates
+  /// located outside the axis are clamped to its boundaries.
+  inline auto operator()(const T coordinate) const noexcept -> uint32_t {
+    auto value = (static_cast<double>(axis_.normalize_coordinate(coordinate)) -
+                  min_) *
+                 scale_;
+    // Also handles NaN
+    if (!(value > 0)) {
+      return 0;
+    }
+    return static_cast<uint32_t>(std::min(value, max_index_));
+  }
+
+ private:
+  const Axis<T>& axis_;
+  double min_;
+  double scale_;
+  double max_index_;
+};
+
+/// Returns the permutation sorting the keys in ascending order, preserving
+/// the order of the equal keys.
+///
+/// The keys are sorted by a least significant digit radix sort, 12 bits at a
+/// time: the keys of 24 bits, used to sort the points on a grid, are sorted
+/// in two passes. The passes on the bits above the highest bit set in the
+/// keys, or shared by all keys, are skipped. The histograms and the moves of
+/// each pass are calculated in parallel on blocks of keys.
+///
+/// @param keys Keys to sort
+/// @param num_threads The number of threads to use for the computation. If 0
+/// all CPUs are used. If 1 is given, no parallel computing code is used at
+/// all.
+/// @return The indexes of the keys in the sorted order
+inline auto argsort(std::vector<uint64_t> keys, size_t num_threads)
+    -> std::vector<int64_t> {
+  constexpr uint32_t kDigitBits = 12;
+  constexpr uint64_t kMask = (uint64_t(1) << kDigitBits) - 1;
+  const auto size = keys.size();
+
+  if (num_threads == 0) {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  // Blocks of keys processed by each thread
+  const auto blocks = std::max<size_t>(std::min(num_threads, size), 1);
+  auto boundary = [&](const size_t block) { return block * size / blocks; };
+
+  // The indexes are filled by the first pass performed
+  auto indexes = std::vector<int64_t>();
+  auto sorted_keys = std::vector<uint64_t>(size);
+  auto sorted_indexes = std::vector<int64_t>(size);
+  auto histograms = std::vector<std::vector<size_t>>(
+      blocks, std::vector<size_t>(kMask + 1));
+
+  const auto max_key =
+      size == 0 ? uint64_t(0) : *std::max_element(keys.begin(), keys.end());
+
+  for (uint32_t shift = 0; shift < 64 && (max_key >> shift) != 0;
+       shift += kDigitBits) {
+    // Histogram of the digits of each block
+    dispatch(
+        [&](size_t start, size_t end) {
+          for (auto block = start; block < end; ++block) {
+            auto& histogram = histograms[block];
+            const auto last = boundary(block + 1);
+            std::fill(histogram.begin(), histogram.end(), 0);
+            for (auto ix = boundary(block); ix < last; ++ix) {
+              ++histogram[(keys[ix] >> shift) & kMask];
+            }
+          }
+        },
+        blocks, num_threads);
+
+    // If all keys share the same digit, this pass does not change anything.
+    auto skip = false;
+    for (size_t digit = 0; digit <= kMask && !skip; ++digit) {
+      auto count = size_t(0);
+      for (const auto& histogram : histograms) {
+        count += histogram[digit];
+      }
+      skip = count == size;
+    }
+    if (skip) {
+      continue;
+    }
+
+    // Position of the first key of each digit in each block
+    auto offset = size_t(0);
+    for (size_t digit = 0; digit <= kMask; ++digit) {
+      for (auto& histogram : histograms) {
+        auto count = histogram[digit];
+        histogram[digit] = offset;
+        offset += count;
+      }
+    }
+
+    dispatch(
+        [&](size_t start, size_t end) {
+          for (auto block = start; block < end; ++block) {
+            auto& position = histograms[block];
+            const auto last = boundary(block + 1);
+            for (auto ix = boundary(block); ix < last; ++ix) {
+              auto jx = position[(keys[ix] >> shift) & kMask]++;
+              sorted_keys[jx] = keys[ix];
+              sorted_indexes[jx] =
+                  indexes.empty() ? static_cast<int64_t>(ix) : indexes[ix];
+            }
+          }
+        },
+        blocks, num_threads);
+
+    keys.swap(sorted_keys);
+    if (indexes.empty()) {
+      indexes.resize(size);
+    }
+    indexes.swap(sorted_indexes);
+  }
+
+  // The keys are already sorted
+  if (indexes.empty()) {
+    indexes.resize(size);
+    std::iota(indexes.begin(), indexes.end(), 0);
+  }
+  return indexes;
+}
+
+}  // namespace pyinterp::detail
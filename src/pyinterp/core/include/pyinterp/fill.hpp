@@ -76,8 +76,31 @@ void set_zonal_average(
   }
 }
 
+/// Gets the index preceding a given index along an axis, the first index
+/// being mirrored unless the axis is a circle.
+inline auto previous_index(const int64_t index, const int64_t size,
+                           const bool is_circle) -> int64_t {
+  if (index != 0) {
+    return index - 1;
+  }
+  return is_circle || size == 1 ? size - 1 : 1;
+}
+
+/// Gets the index following a given index along an axis, the last index
+/// being mirrored unless the axis is a circle.
+inline auto next_index(const int64_t index, const int64_t size,
+                       const bool is_circle) -> int64_t {
+  if (index != size - 1) {
+    return index + 1;
+  }
+  return is_circle || size == 1 ? 0 : size - 2;
+}
+
 ///  Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
-///  method by relaxation.
+///  method by relaxation. The cells are relaxed in red-black order: a cell
+///  of one colour only depends on cells of the other colour, so the columns
+///  of the grid are relaxed concurrently and the result does not depend on
+///  the number of threads.
 ///
 /// @param grid The grid to be processed
 /// @param is_circle True if the X axis of the grid defines a circle.
@@ -89,6 +112,83 @@ auto gauss_seidel(
         grid,
     Eigen::Matrix<bool, -1, -1>& mask, const bool is_circle,
     const Type relaxation, const size_t num_threads) -> Type {
+  // Shape of the grid
+  auto x_size = static_cast<int64_t>(grid.rows());
+  auto y_size = static_cast<int64_t>(grid.cols());
+
+  // Maximum residual values for each column.
+  auto max_residuals = std::vector<Type>(y_size, Type(0));
+
+  // Captures the detected exceptions in the calculation function
+  // (only the last exception captured is kept)
+  auto except = std::exception_ptr(nullptr);
+
+  // Thread worker responsible for relaxing the cells of one colour, i.e.
+  // (ix + iy) % 2 == color, on several columns of the grid. The neighbors
+  // along Y of these cells have the other colour, which allows the columns
+  // to be processed in any order.
+  //
+  // @param color Colour of the cells to be processed.
+  // @param y_start First index y of the band to be processed.
+  // @param y_end Last index y, excluded, of the band to be processed.
+  auto worker = [&](const int64_t color, const int64_t y_start,
+                    const int64_t y_end) -> void {
+    try {
+      for (auto iy = y_start; iy < y_end; ++iy) {
+        auto iy0 = previous_index(iy, y_size, false);
+        auto iy1 = next_index(iy, y_size, false);
+        auto max_residual = max_residuals[iy];
+
+        // The cells are contiguous along the X axis.
+        for (auto ix = (iy + color) % 2; ix < x_size; ix += 2) {
+          if (mask(ix, iy)) {
+            auto ix0 = previous_index(ix, x_size, is_circle);
+            auto ix1 = next_index(ix, x_size, is_circle);
+            auto residual = (Type(0.25) * (grid(ix0, iy) + grid(ix1, iy) +
+                                           grid(ix, iy0) + grid(ix, iy1)) -
+                             grid(ix, iy)) *
+                            relaxation;
+            grid(ix, iy) += residual;
+            max_residual = std::max(max_residual, std::fabs(residual));
+          }
+        }
+        max_residuals[iy] = max_residual;
+      }
+    } catch (...) {
+      except = std::current_exception();
+    }
+  };
+
+  for (int64_t color = 0; color < 2; ++color) {
+    detail::dispatch(
+        [&](size_t y_start, size_t y_end) {
+          worker(color, static_cast<int64_t>(y_start),
+                 static_cast<int64_t>(y_end));
+        },
+        y_size, num_threads);
+  }
+
+  if (except != nullptr) {
+    std::rethrow_exception(except);
+  }
+  return *std::max_element(max_residuals.begin(), max_residuals.end());
+}
+
+///  Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
+///  method by relaxation, in lexicographic order. The grid is split into
+///  bands of columns processed by pipelined threads: a thread relaxes a row
+///  of its band once the previous band has processed it.
+///
+/// @param grid The grid to be processed
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @param relaxation Relaxation constant
+/// @return maximum residual value
+template <typename Type>
+auto gauss_seidel_pipelined(
+    pybind11::EigenDRef<Eigen::Matrix<Type, Eigen::Dynamic, Eigen::Dynamic>>&
+        grid,
+    Eigen::Matrix<bool, -1, -1>& mask, const bool is_circle,
+    const Type relaxation, const size_t num_threads) -> Type {
   // Maximum residual values for each thread.
   std::vector<Type> max_residuals(num_threads);
 
@@ -200,6 +300,222 @@ auto gauss_seidel(
   return *std::max_element(max_residuals.begin(), max_residuals.end());
 }
 
+/// Level of the grid hierarchy processed by the multigrid solver. The
+/// equation solved on a level is, for each undefined cell:
+/// wx (e[i-1,j] + e[i+1,j] - 2 e[i,j]) + wy (e[i,j-1] + e[i,j+1] - 2 e[i,j])
+/// = rhs[i,j]
+template <typename Type>
+struct MultigridLevel {
+  /// Cells solved on this level
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> mask;
+  /// Right-hand side of the equation
+  Eigen::Matrix<Type, Eigen::Dynamic, Eigen::Dynamic> rhs;
+  /// Correction computed on this level (unused on the finest level)
+  Eigen::Matrix<Type, Eigen::Dynamic, Eigen::Dynamic> error;
+  /// Weights of the finite differences along X and Y
+  Type wx{1};
+  Type wy{1};
+  /// True if the X (resp. Y) axis is halved compared to the finer level
+  bool coarsen_x{false};
+  bool coarsen_y{false};
+};
+
+/// Builds the grid hierarchy processed by the multigrid solver. A coarse
+/// cell is solved only if all the fine cells it covers are undefined;
+/// otherwise its correction is zero.
+///
+/// @param mask Undefined values of the grid
+/// @return the levels, from the finest to the coarsest
+template <typename Type>
+auto multigrid_levels(const Eigen::Matrix<bool, -1, -1>& mask)
+    -> std::vector<MultigridLevel<Type>> {
+  auto levels = std::vector<MultigridLevel<Type>>(1);
+  levels[0].mask = mask;
+  levels[0].rhs.setZero(mask.rows(), mask.cols());
+
+  while (levels.back().mask.rows() > 2 || levels.back().mask.cols() > 2) {
+    const auto& fine = levels.back();
+    auto coarse = MultigridLevel<Type>();
+    coarse.coarsen_x = fine.mask.rows() > 2;
+    coarse.coarsen_y = fine.mask.cols() > 2;
+    coarse.wx = coarse.coarsen_x ? fine.wx / 4 : fine.wx;
+    coarse.wy = coarse.coarsen_y ? fine.wy / 4 : fine.wy;
+    coarse.mask.setConstant(
+        coarse.coarsen_x ? (fine.mask.rows() + 1) / 2 : fine.mask.rows(),
+        coarse.coarsen_y ? (fine.mask.cols() + 1) / 2 : fine.mask.cols(),
+        true);
+    for (int64_t iy = 0; iy < fine.mask.cols(); ++iy) {
+      for (int64_t ix = 0; ix < fine.mask.rows(); ++ix) {
+        if (!fine.mask(ix, iy)) {
+          coarse.mask(coarse.coarsen_x ? ix / 2 : ix,
+                      coarse.coarsen_y ? iy / 2 : iy) = false;
+        }
+      }
+    }
+    // Nothing left to solve on the coarser levels.
+    if (!coarse.mask.any()) {
+      break;
+    }
+    coarse.rhs.setZero(coarse.mask.rows(), coarse.mask.cols());
+    coarse.error.setZero(coarse.mask.rows(), coarse.mask.cols());
+    levels.emplace_back(std::move(coarse));
+  }
+  return levels;
+}
+
+/// Relaxes the undefined cells of a level with a Gauss-Seidel sweep.
+///
+/// @return the maximum change applied to a cell
+template <typename Type, typename Matrix>
+auto multigrid_relax(Matrix& u, const MultigridLevel<Type>& level,
+                     const bool is_circle) -> Type {
+  const auto x_size = static_cast<int64_t>(level.mask.rows());
+  const auto y_size = static_cast<int64_t>(level.mask.cols());
+  const auto diagonal = 2 * (level.wx + level.wy);
+  auto max_residual = Type(0);
+
+  for (int64_t iy = 0; iy < y_size; ++iy) {
+    auto iy0 = previous_index(iy, y_size, false);
+    auto iy1 = next_index(iy, y_size, false);
+    for (int64_t ix = 0; ix < x_size; ++ix) {
+      if (level.mask(ix, iy)) {
+        auto ix0 = previous_index(ix, x_size, is_circle);
+        auto ix1 = next_index(ix, x_size, is_circle);
+        auto residual = (level.wx * (u(ix0, iy) + u(ix1, iy)) +
+                         level.wy * (u(ix, iy0) + u(ix, iy1)) -
+                         level.rhs(ix, iy)) /
+                            diagonal -
+                        u(ix, iy);
+        u(ix, iy) += residual;
+        max_residual = std::max(max_residual, std::fabs(residual));
+      }
+    }
+  }
+  return max_residual;
+}
+
+/// Restricts the residual of a level to the right-hand side of the coarser
+/// level, averaging the residuals of the fine cells covered by each coarse
+/// cell.
+template <typename Type, typename Matrix>
+auto multigrid_restrict(const Matrix& u, const MultigridLevel<Type>& fine,
+                        MultigridLevel<Type>& coarse, const bool is_circle)
+    -> void {
+  const auto x_size = static_cast<int64_t>(fine.mask.rows());
+  const auto y_size = static_cast<int64_t>(fine.mask.cols());
+  const auto diagonal = 2 * (fine.wx + fine.wy);
+
+  coarse.rhs.setZero();
+  for (int64_t iy = 0; iy < y_size; ++iy) {
+    auto iy0 = previous_index(iy, y_size, false);
+    auto iy1 = next_index(iy, y_size, false);
+    auto jy = coarse.coarsen_y ? iy / 2 : iy;
+    for (int64_t ix = 0; ix < x_size; ++ix) {
+      auto jx = coarse.coarsen_x ? ix / 2 : ix;
+      if (coarse.mask(jx, jy)) {
+        auto ix0 = previous_index(ix, x_size, is_circle);
+        auto ix1 = next_index(ix, x_size, is_circle);
+        coarse.rhs(jx, jy) +=
+            fine.rhs(ix, iy) - fine.wx * (u(ix0, iy) + u(ix1, iy)) -
+            fine.wy * (u(ix, iy0) + u(ix, iy1)) + diagonal * u(ix, iy);
+      }
+    }
+  }
+
+  // Number of fine cells covered by a coarse cell
+  auto children = [](const int64_t index, const int64_t size,
+                     const bool coarsened) -> Type {
+    return coarsened && 2 * index + 1 < size ? Type(2) : Type(1);
+  };
+  for (int64_t jy = 0; jy < coarse.mask.cols(); ++jy) {
+    auto ny = children(jy, y_size, coarse.coarsen_y);
+    for (int64_t jx = 0; jx < coarse.mask.rows(); ++jx) {
+      coarse.rhs(jx, jy) /= ny * children(jx, x_size, coarse.coarsen_x);
+    }
+  }
+}
+
+/// Gets the two coarse cells framing a fine cell along an axis, the first
+/// being the nearest.
+inline auto multigrid_parents(const int64_t index, const int64_t size,
+                              const bool coarsened, const bool is_circle)
+    -> std::tuple<int64_t, int64_t> {
+  if (!coarsened) {
+    return std::make_tuple(index, index);
+  }
+  auto nearest = index / 2;
+  auto other = index % 2 == 0 ? nearest - 1 : nearest + 1;
+  if (other < 0 || other >= size) {
+    other = is_circle ? (other + size) % size : nearest;
+  }
+  return std::make_tuple(nearest, other);
+}
+
+/// Adds to the undefined cells of a level the correction calculated on the
+/// coarser level, interpolated bilinearly.
+template <typename Type, typename Matrix>
+auto multigrid_prolongate(const MultigridLevel<Type>& coarse,
+                          const MultigridLevel<Type>& fine, Matrix& u,
+                          const bool is_circle) -> void {
+  const auto& e = coarse.error;
+  for (int64_t iy = 0; iy < fine.mask.cols(); ++iy) {
+    auto [jy0, jy1] =
+        multigrid_parents(iy, e.cols(), coarse.coarsen_y, false);
+    for (int64_t ix = 0; ix < fine.mask.rows(); ++ix) {
+      if (fine.mask(ix, iy)) {
+        auto [jx0, jx1] =
+            multigrid_parents(ix, e.rows(), coarse.coarsen_x, is_circle);
+        u(ix, iy) += Type(0.5625) * e(jx0, jy0) +
+                     Type(0.1875) * (e(jx1, jy0) + e(jx0, jy1)) +
+                     Type(0.0625) * e(jx1, jy1);
+      }
+    }
+  }
+}
+
+/// Performs a cycle of the multigrid solver from a given level. The coarse
+/// grid correction is computed by two cycles on the coarser level (W-cycle),
+/// which compensates for the coarse cells left out of the solve along the
+/// edges of the undefined areas.
+///
+/// @param u Values (finest level) or correction (coarser levels) to update
+/// @param levels Grid hierarchy
+/// @param index Index of the level processed
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @return the maximum change applied to a cell by the last relaxation sweep
+template <typename Type, typename Matrix>
+auto multigrid_cycle(Matrix& u, std::vector<MultigridLevel<Type>>& levels,
+                     const size_t index, const bool is_circle) -> Type {
+  // Number of relaxation sweeps before and after the coarse grid correction
+  constexpr size_t kSweeps = 2;
+  // Number of relaxation sweeps solving the coarsest level (at most 2x2
+  // cells)
+  constexpr size_t kCoarsestSweeps = 32;
+
+  auto& level = levels[index];
+  auto max_residual = Type(0);
+  if (index + 1 == levels.size()) {
+    for (size_t ix = 0; ix < kCoarsestSweeps; ++ix) {
+      max_residual = multigrid_relax(u, level, is_circle);
+    }
+    return max_residual;
+  }
+  for (size_t ix = 0; ix < kSweeps; ++ix) {
+    multigrid_relax(u, level, is_circle);
+  }
+  auto& coarse = levels[index + 1];
+  multigrid_restrict(u, level, coarse, is_circle);
+  coarse.error.setZero();
+  for (size_t ix = 0; ix < 2; ++ix) {
+    multigrid_cycle(coarse.error, levels, index + 1, is_circle);
+  }
+  multigrid_prolongate(coarse, level, u, is_circle);
+  for (size_t ix = 0; ix < kSweeps; ++ix) {
+    max_residual = multigrid_relax(u, level, is_circle);
+  }
+  return max_residual;
+}
+
 }  // namespace detail
 
 namespace fill {
@@ -210,6 +526,43 @@ enum FirstGuess {
   kZonalAverage,  //!< Use zonal average in x direction
 };
 
+/// Order in which the Gauss-Seidel method relaxes the cells.
+enum Sweep {
+  kRedBlack,   //!< Cells of one colour relaxed concurrently
+  kPipelined,  //!< Lexicographic order, bands processed by pipelined threads
+};
+
+/// Replaces the undefined values (NaN) of a grid with the first guess chosen.
+///
+/// @param grid The grid to be processed
+/// @param first_guess Type of first guess
+/// @param num_threads The number of threads to use for the computation.
+/// @return the mask of the undefined values of the grid.
+template <typename Type>
+auto set_first_guess(
+    pybind11::EigenDRef<Eigen::Matrix<Type, Eigen::Dynamic, Eigen::Dynamic>>&
+        grid,
+    const FirstGuess first_guess, const size_t num_threads)
+    -> Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> {
+  /// Calculation of the position of the undefined values on the grid.
+  auto mask =
+      Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>(grid.array().isNaN());
+
+  /// Calculation of the first guess with the chosen method
+  switch (first_guess) {
+    case FirstGuess::kZero:
+      grid = (mask.array()).select(0, grid);
+      break;
+    case FirstGuess::kZonalAverage:
+      detail::set_zonal_average(grid, mask, num_threads);
+      break;
+    default:
+      throw std::invalid_argument("Invalid guess type: " +
+                                  std::to_string(first_guess));
+  }
+  return mask;
+}
+
 /// Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
 /// method by relaxation.
 ///
@@ -222,6 +575,7 @@ enum FirstGuess {
 /// @param num_threads The number of threads to use for the computation. If 0
 /// all CPUs are used. If 1 is given, no parallel computing code is used at all,
 /// which is useful for debugging.
+/// @param sweep Order in which the cells are relaxed
 /// @return A tuple containing the number of iterations performed and the
 /// maximum residual value.
 template <typename Type>
@@ -230,7 +584,7 @@ auto gauss_seidel(
         grid,
     const FirstGuess first_guess, const bool is_circle,
     const size_t max_iterations, const Type epsilon, const Type relaxation,
-    size_t num_threads) -> std::tuple<size_t, Type> {
+    size_t num_threads, const Sweep sweep) -> std::tuple<size_t, Type> {
   /// If the grid doesn't have an undefined value, this routine has nothing more
   /// to do.
   if (!grid.hasNaN()) {
@@ -242,22 +596,63 @@ auto gauss_seidel(
     num_threads = std::thread::hardware_concurrency();
   }
 
-  /// Calculation of the position of the undefined values on the grid.
-  auto mask =
-      Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>(grid.array().isNaN());
+  auto mask = set_first_guess(grid, first_guess, num_threads);
 
-  /// Calculation of the first guess with the chosen method
-  switch (first_guess) {
-    case FirstGuess::kZero:
-      grid = (mask.array()).select(0, grid);
-      break;
-    case FirstGuess::kZonalAverage:
-      detail::set_zonal_average(grid, mask, num_threads);
+  // Initialization of the function results.
+  size_t iteration = 0;
+  Type max_residual = 0;
+
+  for (size_t it = 0; it < max_iterations; ++it) {
+    ++iteration;
+    max_residual =
+        sweep == kPipelined
+            ? detail::gauss_seidel_pipelined<Type>(grid, mask, is_circle,
+                                                   relaxation, num_threads)
+            : detail::gauss_seidel<Type>(grid, mask, is_circle, relaxation,
+                                         num_threads);
+    if (max_residual < epsilon) {
       break;
-    default:
-      throw std::invalid_argument("Invalid guess type: " +
-                                  std::to_string(first_guess));
+    }
   }
+  return std::make_tuple(iteration, max_residual);
+}
+
+/// Replaces all undefined values (NaN) in a grid by solving the same Poisson
+/// problem as gauss_seidel with a geometric multigrid method: each cycle
+/// relaxes the grid with Gauss-Seidel sweeps and corrects it with the
+/// solution of the residual equation on coarser grids, which makes the
+/// number of cycles independent of the size of the grid and of its gaps.
+///
+/// @param grid The grid to be processed
+/// @param first_guess Type of first guess
+/// @param is_circle True if the X axis of the grid defines a circle.
+/// @param max_iterations Maximum number of cycles.
+/// @param epsilon Tolerance for ending the cycles before the maximum number
+/// of iterations limit.
+/// @param num_threads The number of threads to use for the computation of
+/// the first guess. If 0 all CPUs are used.
+/// @return A tuple containing the number of cycles performed and the
+/// maximum residual value.
+template <typename Type>
+auto multigrid(
+    pybind11::EigenDRef<Eigen::Matrix<Type, Eigen::Dynamic, Eigen::Dynamic>>&
+        grid,
+    const FirstGuess first_guess, const bool is_circle,
+    const size_t max_iterations, const Type epsilon, size_t num_threads)
+    -> std::tuple<size_t, Type> {
+  /// If the grid doesn't have an undefined value, this routine has nothing more
+  /// to do.
+  if (!grid.hasNaN()) {
+    return std::make_tuple(0, Type(0));
+  }
+
+  /// Calculation of the maximum number of threads if the user chooses.
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+
+  auto mask = set_first_guess(grid, first_guess, num_threads);
+  auto levels = detail::multigrid_levels<Type>(mask);
 
   // Initialization of the function results.
   size_t iteration = 0;
@@ -265,8 +660,7 @@ auto gauss_seidel(
 
   for (size_t it = 0; it < max_iterations; ++it) {
     ++iteration;
-    max_residual = detail::gauss_seidel<Type>(grid, mask, is_circle, relaxation,
-                                              num_threads);
+    max_residual = detail::multigrid_cycle(grid, levels, 0, is_circle);
     if (max_residual < epsilon) {
       break;
     }
@@ -446,8 +840,14 @@ auto loess(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
            const uint32_t ny, const ValueType value_type,
            const size_t num_threads) -> pybind11::array_t<Type> {
   check_windows_size("nx", nx, "ny", ny);
+
+  // Snapshot of the grid: the values replaced by "update_array" or
+  // "update_slice" while the GIL is released are not seen by this
+  // calculation.
+  const auto snapshot = grid;
+
   auto result = pybind11::array_t<Type>(pybind11::array::ShapeContainer{
-      grid.x()->size(), grid.y()->size(), grid.z()->size()});
+      snapshot.x()->size(), snapshot.y()->size(), snapshot.z()->size()});
   auto _result = result.template mutable_unchecked<3>();
 
   // Captures the detected exceptions in the calculation function
@@ -457,8 +857,8 @@ auto loess(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
   auto worker = [&](const size_t start, const size_t end) {
     try {
       // Access to the shared pointer outside the loop to avoid data races
-      const auto& x_axis = *grid.x();
-      const auto& y_axis = *grid.y();
+      const auto& x_axis = *snapshot.x();
+      const auto& y_axis = *snapshot.y();
       auto x_frame = std::vector<int64_t>(nx * 2 + 1);
       auto y_frame = std::vector<int64_t>(ny * 2 + 1);
 
@@ -479,7 +879,7 @@ auto loess(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
           }
 
           for (int64_t iy = 0; iy < y_axis.size(); ++iy) {
-            auto z = grid.value(ix, iy, iz);
+            auto z = snapshot.value(ix, iy, iz);
 
             // If the current value is masked.
             const auto undefined = std::isnan(z);
@@ -505,7 +905,7 @@ auto loess(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
                 }
 
                 for (auto wy : y_frame) {
-                  auto zi = grid.value(wx, wy, iz);
+                  auto zi = snapshot.value(wx, wy, iz);
 
                   // If the value is not masked, its weight is calculated
                   // from the tri-cube weight function
@@ -540,7 +940,7 @@ auto loess(const Grid3D<Type, AxisType>& grid, const uint32_t nx,
 
   {
     pybind11::gil_scoped_release release;
-    detail::dispatch(worker, grid.z()->size(), num_threads);
+    detail::dispatch(worker, snapshot.z()->size(), num_threads);
   }
   return result;
 }
@@ -4,11 +4,25 @@
 // BSD-style license that can be found in the LICENSE file.
 #pragma once
 #include <pybind11/numpy.h>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
 #include "pyinterp/axis.hpp"
 #include "pyinterp/detail/broadcast.hpp"
 
 namespace pyinterp {
 
+namespace detail {
+
+/// Returns a new identifier for the values of a grid, unique in the process.
+inline auto next_grid_id() -> uint64_t {
+  static auto counter = std::atomic<uint64_t>(0);
+  return ++counter;
+}
+
+}  // namespace detail
+
 /// Cartesian Grid 2D
 ///
 /// @tparam DataType Grid data type
@@ -69,10 +83,15 @@ class Grid2D {
     return array_;
   }
 
+  /// Gets the identifier of the values of the grid, unique in the process.
+  /// The copies of the grid share it; it changes when the values are
+  /// replaced.
+  [[nodiscard]] inline auto id() const noexcept -> uint64_t { return id_; }
+
   /// Gets the grid value for the coordinate pixel (ix, iy, ...).
   template <typename... Index>
   inline auto value(Index&&... index) const noexcept -> const DataType& {
-    return ptr_(std::forward<Index>(index)...);
+    return (*ptr_)(std::forward<Index>(index)...);
   }
 
   /// Throws an exception indicating that the value searched on the axis is
@@ -81,8 +100,8 @@ class Grid2D {
   /// @param axis Axis involved.
   /// @param value The value outside the axis domain.
   /// @param axis_label The name of the axis
-  template <typename AxisType>
-  static void index_error(const Axis<AxisType>& axis, const AxisType value,
+  template <typename AxisType, typename T>
+  static void index_error(const Axis<AxisType>& axis, const T value,
                           const std::string& axis_label) {
     throw std::invalid_argument(std::to_string(value) +
                                 " is out ouf bounds for axis " + axis_label +
@@ -111,7 +130,11 @@ class Grid2D {
   std::shared_ptr<Axis<double>> x_;
   std::shared_ptr<Axis<double>> y_;
   pybind11::array_t<DataType> array_;
-  pybind11::detail::unchecked_reference<DataType, Dimension> ptr_;
+  /// Accessor to the values, reset when the values are replaced.
+  std::optional<pybind11::detail::unchecked_reference<DataType, Dimension>>
+      ptr_;
+  /// Identifier of the values
+  uint64_t id_{detail::next_grid_id()};
 
   /// End of the recursive call of the function "check_shape"
   void check_shape(const size_t idx) {}
@@ -146,12 +169,101 @@ class Grid3D : public Grid2D<DataType, Dimension> {
     this->check_shape(2, z_.get(), "z", "array");
   }
 
+  /// Copy constructor: the copy shares the values of the grid but not the
+  /// buffer used to update them. Used by the calculation functions to work
+  /// on a snapshot of the values while the GIL is released.
+  ///
+  /// @param rhs right value
+  Grid3D(const Grid3D& rhs)
+      : Grid2D<DataType, Dimension>(rhs), z_(rhs.z_) {}
+
+  /// Move constructor
+  ///
+  /// @param rhs right value
+  Grid3D(Grid3D&& rhs) noexcept = default;
+
   /// Gets the Y-Axis
   [[nodiscard]] inline auto z() const noexcept
       -> std::shared_ptr<Axis<AxisType>> {
     return z_;
   }
 
+  /// Replaces the values of the grid. The array is referenced, not copied,
+  /// and must not be modified afterwards. The calculations in progress end
+  /// with the previous values, the following ones use the new values.
+  ///
+  /// @param array New values of the grid
+  void update_array(pybind11::array_t<DataType> array) {
+    auto ptr = array.template unchecked<Dimension>();
+    for (auto ix = 0; ix < Dimension; ++ix) {
+      if (array.shape(ix) != this->array_.shape(ix)) {
+        throw std::invalid_argument(
+            "array shape " + detail::ndarray_shape(array) +
+            " does not match the grid shape " +
+            detail::ndarray_shape(this->array_));
+      }
+    }
+    this->array_ = std::move(array);
+    this->ptr_.emplace(ptr);
+    this->id_ = detail::next_grid_id();
+    // The update buffer no longer contains any of the current values.
+    back_.reset();
+    pending_.reset();
+  }
+
+  /// Replaces the values of the grid for the index of the Z-Axis. The
+  /// calculations in progress end with the previous values, the following
+  /// ones use the new values.
+  ///
+  /// The new values are written into a second buffer, swapped with the
+  /// current one once updated. The buffer released is reused by the next
+  /// update if no calculation references it anymore, so that an update only
+  /// copies the slices modified since the previous swap. Otherwise, a new
+  /// buffer is allocated.
+  ///
+  /// @param index Index of the slice on the Z-Axis
+  /// @param values Values of the slice, an array of the grid shape without
+  /// the Z dimension.
+  void update_slice(const int64_t index,
+                    const pybind11::array_t<DataType>& values) {
+    if (index < 0 || index >= this->array_.shape(2)) {
+      throw std::out_of_range("index " + std::to_string(index) +
+                              " is out of range for axis z");
+    }
+    auto _values = values.template unchecked<Dimension - 1>();
+    for (auto ix = 0; ix < Dimension - 1; ++ix) {
+      if (values.shape(ix) != this->array_.shape(ix < 2 ? ix : ix + 1)) {
+        throw std::invalid_argument(
+            "values shape " + detail::ndarray_shape(values) +
+            " does not match the shape of a slice of the grid " +
+            detail::ndarray_shape(this->array_));
+      }
+    }
+
+    if (back_.has_value() && back_->ref_count() == 1) {
+      // The buffer is no longer used: it is updated with the slice modified
+      // by the previous update.
+      if (pending_.has_value() && *pending_ != index) {
+        copy_slice(*pending_, *this->ptr_, *back_);
+      }
+    } else {
+      auto shape = pybind11::array::ShapeContainer(
+          this->array_.shape(), this->array_.shape() + Dimension);
+      back_ = pybind11::array_t<DataType>(shape);
+      for (int64_t iz = 0; iz < this->array_.shape(2); ++iz) {
+        if (iz != index) {
+          copy_slice(iz, *this->ptr_, *back_);
+        }
+      }
+    }
+    copy_slice(index, _values, *back_);
+
+    std::swap(this->array_, *back_);
+    this->ptr_.emplace(this->array_.template unchecked<Dimension>());
+    this->id_ = detail::next_grid_id();
+    pending_ = index;
+  }
+
   /// Pickle support: get state of this instance
   [[nodiscard]] auto getstate() const -> pybind11::tuple override {
     return pybind11::make_tuple(this->x_->getstate(), this->y_->getstate(),
@@ -174,6 +286,44 @@ class Grid3D : public Grid2D<DataType, Dimension> {
 
  protected:
   std::shared_ptr<Axis<AxisType>> z_;
+
+ private:
+  /// Buffer used to update the values of the grid
+  std::optional<pybind11::array_t<DataType>> back_{};
+  /// Index of the slice of the buffer that differs from the current values
+  std::optional<int64_t> pending_{};
+
+  /// Copies the slice "index" of the Z-Axis into the array "target".
+  ///
+  /// @param source Values of the grid, or values of a slice if the
+  /// accessor has one dimension less than the grid.
+  template <ssize_t Dims>
+  static void copy_slice(
+      const int64_t index,
+      const pybind11::detail::unchecked_reference<DataType, Dims>& source,
+      pybind11::array_t<DataType>& target) {
+    auto _target = target.template mutable_unchecked<Dimension>();
+
+    for (int64_t ix = 0; ix < _target.shape(0); ++ix) {
+      for (int64_t iy = 0; iy < _target.shape(1); ++iy) {
+        if constexpr (Dimension == 3) {
+          if constexpr (Dims == Dimension - 1) {
+            _target(ix, iy, index) = source(ix, iy);
+          } else {
+            _target(ix, iy, index) = source(ix, iy, index);
+          }
+        } else {
+          for (int64_t iu = 0; iu < _target.shape(3); ++iu) {
+            if constexpr (Dims == Dimension - 1) {
+              _target(ix, iy, index, iu) = source(ix, iy, iu);
+            } else {
+              _target(ix, iy, index, iu) = source(ix, iy, index, iu);
+            }
+          }
+        }
+      }
+    }
+  }
 };
 
 /// Cartesian Grid 4D
@@ -226,6 +376,94 @@ class Grid4D : public Grid3D<DataType, AxisType, 4> {
   std::shared_ptr<Axis<double>> u_;
 };
 
+/// Cartesian Grid 2D storing several variables sharing the same axes.
+///
+/// The values are stored in an array of shape (nx, ny, k), where k is the
+/// number of variables, so that the values of all the variables of a grid
+/// point are contiguous in memory.
+///
+/// @tparam DataType Grid data type
+template <typename DataType>
+class MultiGrid2D : public Grid2D<DataType, 3> {
+ public:
+  /// Default constructor
+  MultiGrid2D(std::shared_ptr<Axis<double>> x, std::shared_ptr<Axis<double>> y,
+              pybind11::array_t<DataType, pybind11::array::c_style |
+                                              pybind11::array::forcecast>
+                  array)
+      : Grid2D<DataType, 3>(std::move(x), std::move(y), std::move(array)) {}
+
+  /// Gets the number of variables stored in this instance
+  [[nodiscard]] inline auto variables() const noexcept -> ssize_t {
+    return this->array_.shape(2);
+  }
+
+  /// Gets the values of all the variables for the pixel (ix, iy)
+  inline auto values(const int64_t ix, const int64_t iy) const noexcept
+      -> const DataType* {
+    return &(*this->ptr_)(ix, iy, 0);
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> MultiGrid2D {
+    if (tuple.size() != 3) {
+      throw std::runtime_error("invalid state");
+    }
+    return MultiGrid2D(
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[0].cast<pybind11::tuple>())),
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[1].cast<pybind11::tuple>())),
+        tuple[2].cast<pybind11::array_t<DataType>>());
+  }
+};
+
+/// Cartesian Grid 3D storing several variables sharing the same axes.
+///
+/// The values are stored in an array of shape (nx, ny, nz, k), where k is
+/// the number of variables.
+///
+/// @tparam DataType Grid data type
+/// @tparam AxisType Axis data type
+template <typename DataType, typename AxisType>
+class MultiGrid3D : public Grid3D<DataType, AxisType, 4> {
+ public:
+  /// Default constructor
+  MultiGrid3D(const std::shared_ptr<Axis<double>>& x,
+              const std::shared_ptr<Axis<double>>& y,
+              std::shared_ptr<Axis<AxisType>> z,
+              pybind11::array_t<DataType, pybind11::array::c_style |
+                                              pybind11::array::forcecast>
+                  array)
+      : Grid3D<DataType, AxisType, 4>(x, y, std::move(z), std::move(array)) {}
+
+  /// Gets the number of variables stored in this instance
+  [[nodiscard]] inline auto variables() const noexcept -> ssize_t {
+    return this->array_.shape(3);
+  }
+
+  /// Gets the values of all the variables for the pixel (ix, iy, iz)
+  inline auto values(const int64_t ix, const int64_t iy,
+                     const int64_t iz) const noexcept -> const DataType* {
+    return &(*this->ptr_)(ix, iy, iz, 0);
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> MultiGrid3D {
+    if (tuple.size() != 4) {
+      throw std::runtime_error("invalid state");
+    }
+    return MultiGrid3D(
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[0].cast<pybind11::tuple>())),
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[1].cast<pybind11::tuple>())),
+        std::make_shared<Axis<AxisType>>(
+            Axis<AxisType>::setstate(tuple[2].cast<pybind11::tuple>())),
+        tuple[3].cast<pybind11::array_t<DataType>>());
+  }
+};
+
 /// Implementations of Cartesian grids with N dimensions.
 ///
 /// @tparam DataType Grid data type
@@ -291,6 +529,33 @@ Gets the values handled by this instance
 
 Return:
     numpy.ndarray: values
+)__doc__")
+      .def("update_array", &Grid3D<DataType, AxisType>::update_array,
+           pybind11::arg("array"),
+           R"__doc__(
+Replaces the values of the grid. The array is referenced, not copied, and must
+not be modified afterwards. The interpolations in progress end with the
+previous values, the following ones use the new values.
+
+Args:
+    array (numpy.ndarray): New values of the grid, with the same shape as the
+        current values.
+)__doc__")
+      .def("update_slice", &Grid3D<DataType, AxisType>::update_slice,
+           pybind11::arg("index"), pybind11::arg("values"),
+           R"__doc__(
+Replaces the values of the grid for an index of the Z-Axis. The
+interpolations in progress end with the previous values, the following ones
+use the new values.
+
+The new values are written into a second buffer, swapped with the current one
+once updated: an update only copies the slices modified since the previous
+update, unless an interpolation still uses this buffer.
+
+Args:
+    index (int): Index of the slice on the Z-Axis.
+    values (numpy.ndarray): Values of the slice, an array of the grid shape
+        without the Z dimension.
 )__doc__")
       .def(pybind11::pickle(
           [](const Grid3D<DataType, AxisType>& self) {
@@ -366,6 +631,33 @@ Gets the values handled by this instance
 
 Return:
     numpy.ndarray: values
+)__doc__")
+      .def("update_array", &Grid4D<DataType, AxisType>::update_array,
+           pybind11::arg("array"),
+           R"__doc__(
+Replaces the values of the grid. The array is referenced, not copied, and must
+not be modified afterwards. The interpolations in progress end with the
+previous values, the following ones use the new values.
+
+Args:
+    array (numpy.ndarray): New values of the grid, with the same shape as the
+        current values.
+)__doc__")
+      .def("update_slice", &Grid4D<DataType, AxisType>::update_slice,
+           pybind11::arg("index"), pybind11::arg("values"),
+           R"__doc__(
+Replaces the values of the grid for an index of the Z-Axis. The
+interpolations in progress end with the previous values, the following ones
+use the new values.
+
+The new values are written into a second buffer, swapped with the current one
+once updated: an update only copies the slices modified since the previous
+update, unless an interpolation still uses this buffer.
+
+Args:
+    index (int): Index of the slice on the Z-Axis.
+    values (numpy.ndarray): Values of the slice, an array of the grid shape
+        without the Z dimension.
 )__doc__")
       .def(pybind11::pickle(
           [](const Grid4D<DataType, AxisType>& self) {
@@ -374,6 +666,90 @@ Return:
           [](const pybind11::tuple& state) {
             return Grid4D<DataType, AxisType>::setstate(state);
           }));
+
+  help = "Cartesian Grid 3D storing several variables";
+  if (prefix.length()) {
+    help = prefix + " " + help;
+  }
+  pybind11::class_<MultiGrid3D<DataType, AxisType>>(
+      m, (prefix + "MultiGrid3D" + suffix).c_str(), help.c_str())
+      .def(pybind11::init<
+               std::shared_ptr<Axis<double>>, std::shared_ptr<Axis<double>>,
+               std::shared_ptr<Axis<AxisType>>,
+               pybind11::array_t<DataType, pybind11::array::c_style |
+                                               pybind11::array::forcecast>>(),
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+           pybind11::arg("array"),
+           (R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    z (pyinterp.core.)__doc__" +
+            prefix + R"__doc__(Axis): Z-Axis
+    array (numpy.ndarray): Trivariate functions, stored in an array of shape
+        ``(nx, ny, nz, k)`` where ``k`` is the number of variables.
+)__doc__")
+               .c_str())
+      .def_property_readonly(
+          "x",
+          [](const MultiGrid3D<DataType, AxisType>& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y",
+          [](const MultiGrid3D<DataType, AxisType>& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def_property_readonly(
+          "z",
+          [](const MultiGrid3D<DataType, AxisType>& self) { return self.z(); },
+          (R"__doc__(
+Gets the Z-Axis handled by this instance
+
+Return:
+    pyinterp.core.)__doc__" +
+           prefix + R"__doc__(Axis: Z-Axis
+)__doc__")
+              .c_str())
+      .def_property_readonly(
+          "variables",
+          [](const MultiGrid3D<DataType, AxisType>& self) {
+            return self.variables();
+          },
+          R"__doc__(
+Gets the number of variables handled by this instance
+
+Return:
+    int: number of variables
+)__doc__")
+      .def_property_readonly(
+          "array",
+          [](const MultiGrid3D<DataType, AxisType>& self) {
+            return self.array();
+          },
+          R"__doc__(
+Gets the values handled by this instance
+
+Return:
+    numpy.ndarray: values
+)__doc__")
+      .def(pybind11::pickle(
+          [](const MultiGrid3D<DataType, AxisType>& self) {
+            return self.getstate();
+          },
+          [](const pybind11::tuple& state) {
+            return MultiGrid3D<DataType, AxisType>::setstate(state);
+          }));
 }
 
 /// Implementations of Cartesian grids.
@@ -425,6 +801,64 @@ Return:
             return Grid2D<DataType>::setstate(state);
           }));
 
+  pybind11::class_<MultiGrid2D<DataType>>(
+      m, ("MultiGrid2D" + suffix).c_str(),
+      "Cartesian Grid 2D storing several variables")
+      .def(pybind11::init<std::shared_ptr<Axis<double>>,
+                          std::shared_ptr<Axis<double>>,
+                          pybind11::array_t<DataType,
+                                            pybind11::array::c_style |
+                                                pybind11::array::forcecast>>(),
+           pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("array"),
+           R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis
+    y (pyinterp.core.Axis): Y-Axis
+    array (numpy.ndarray): Bivariate functions, stored in an array of shape
+        ``(nx, ny, k)`` where ``k`` is the number of variables.
+)__doc__")
+      .def_property_readonly(
+          "x", [](const MultiGrid2D<DataType>& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const MultiGrid2D<DataType>& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def_property_readonly(
+          "variables",
+          [](const MultiGrid2D<DataType>& self) { return self.variables(); },
+          R"__doc__(
+Gets the number of variables handled by this instance
+
+Return:
+    int: number of variables
+)__doc__")
+      .def_property_readonly(
+          "array",
+          [](const MultiGrid2D<DataType>& self) { return self.array(); },
+          R"__doc__(
+Gets the values handled by this instance
+
+Return:
+    numpy.ndarray: values
+)__doc__")
+      .def(pybind11::pickle(
+          [](const MultiGrid2D<DataType>& self) { return self.getstate(); },
+          [](const pybind11::tuple& state) {
+            return MultiGrid2D<DataType>::setstate(state);
+          }));
+
   implement_ndgrid<DataType, double>(m, "", suffix);
   implement_ndgrid<DataType, int64_t>(m, "Temporal", suffix);
 }
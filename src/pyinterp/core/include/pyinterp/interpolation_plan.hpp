@@ -0,0 +1,585 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <Eigen/Core>
+#include <limits>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "pyinterp/axis.hpp"
+#include "pyinterp/detail/broadcast.hpp"
+#include "pyinterp/detail/math.hpp"
+#include "pyinterp/detail/math/bivariate.hpp"
+#include "pyinterp/detail/math/trivariate.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/grid.hpp"
+#include "pyinterp/ndarray.hpp"
+#include "pyinterp/output.hpp"
+
+namespace pyinterp {
+
+namespace detail {
+
+/// Calculates the weights applied by an interpolator to the values of the
+/// points of the cells containing the query points.
+///
+/// @param interpolator Interpolator used
+/// @param function Function called with the interpolator cast to its concrete
+/// type, providing the method "weights".
+template <template <class> class Point, typename T, typename Function>
+inline void visit_weights(const math::Bivariate<Point, T>* interpolator,
+                          Function&& function) {
+  math::visit(interpolator, [&](const auto& impl) {
+    using Interpolator = std::decay_t<decltype(impl)>;
+    if constexpr (std::is_same_v<Interpolator, math::Bivariate<Point, T>>) {
+      throw std::invalid_argument(
+          "the weights of this interpolator cannot be computed in advance");
+    } else {
+      function(impl, !std::is_same_v<Interpolator, math::Bilinear<Point, T>>);
+    }
+  });
+}
+
+}  // namespace detail
+
+/// Interpolation of bivariate functions, sharing the same axes, at a fixed
+/// set of points.
+///
+/// The axes are searched and the weights of the interpolator are calculated
+/// once, when the plan is created. The interpolation of a grid is then a
+/// weighted sum of the values of the points of the cells containing the
+/// query points.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+template <typename Coordinate>
+class BivariatePlan {
+ public:
+  /// Indexes (ix0, ix1, iy0, iy1) of the cells containing the points
+  using Indexes = Eigen::Matrix<int64_t, Eigen::Dynamic, 4, Eigen::RowMajor>;
+
+  /// Weights of the values (x0, y0), (x0, y1), (x1, y0) and (x1, y1) of the
+  /// cells. The weights of the points located outside the grid are NaN.
+  using Weights =
+      Eigen::Matrix<Coordinate, Eigen::Dynamic, 4, Eigen::RowMajor>;
+
+  /// Shape of the arrays of points
+  using Shape = std::vector<pybind11::ssize_t>;
+
+  /// Creates the plan interpolating the points with the given interpolator.
+  ///
+  /// @param x X-Axis of the grids
+  /// @param y Y-Axis of the grids
+  /// @param x_values X-coordinates of the points
+  /// @param y_values Y-coordinates of the points
+  /// @param interpolator Interpolator used
+  /// @param bounds_error If true, an exception is thrown if a point is
+  /// located outside the grid.
+  /// @param num_threads The number of threads to use for the computation.
+  template <template <class> class Point>
+  BivariatePlan(std::shared_ptr<Axis<double>> x,
+                std::shared_ptr<Axis<double>> y,
+                const pybind11::array_t<Coordinate>& x_values,
+                const pybind11::array_t<Coordinate>& y_values,
+                const detail::math::Bivariate<Point, Coordinate>* interpolator,
+                const bool bounds_error, const size_t num_threads)
+      : BivariatePlan(std::move(x), std::move(y), shape_of(x_values)) {
+    detail::check_ndarray_shape("x", x_values, "y", y_values);
+
+    auto _x = FlatView<Coordinate>(x_values);
+    auto _y = FlatView<Coordinate>(y_values);
+
+    pybind11::gil_scoped_release release;
+
+    // Captures the detected exceptions in the calculation function
+    // (only the last exception captured is kept)
+    auto except = std::exception_ptr(nullptr);
+
+    // Access to the shared pointer outside the loop to avoid data races
+    const auto& x_axis = *x_;
+    const auto& y_axis = *y_;
+
+    detail::visit_weights(interpolator, [&](const auto& impl,
+                                            const bool select) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            try {
+              for (size_t ix = start; ix < end; ++ix) {
+                auto x_indexes = x_axis.find_indexes(_x(ix));
+                auto y_indexes = y_axis.find_indexes(_y(ix));
+
+                if (x_indexes.has_value() && y_indexes.has_value()) {
+                  int64_t ix0;
+                  int64_t ix1;
+                  int64_t iy0;
+                  int64_t iy1;
+
+                  std::tie(ix0, ix1) = *x_indexes;
+                  std::tie(iy0, iy1) = *y_indexes;
+
+                  auto x0 = x_axis(ix0);
+                  auto x1 = x_axis(ix1);
+                  auto xi = _x(ix);
+                  if (x_axis.is_angle()) {
+                    xi = detail::math::normalize_angle(xi, x0, 360.0);
+                    x1 = detail::math::normalize_angle(x1, x0, 360.0);
+                  }
+
+                  auto weights = impl.weights(
+                      Point<Coordinate>(xi, _y(ix)),
+                      Point<Coordinate>(x0, y_axis(iy0)),
+                      Point<Coordinate>(x1, y_axis(iy1)));
+                  if (select) {
+                    detail::math::select_point(weights, ix0, ix1, iy0, iy1);
+                  }
+                  indexes_.row(ix) << ix0, ix1, iy0, iy1;
+                  weights_.row(ix) = weights.transpose();
+                } else {
+                  if (bounds_error) {
+                    if (!x_indexes.has_value()) {
+                      Grid2D<Coordinate>::index_error(x_axis, _x(ix), "x");
+                    }
+                    Grid2D<Coordinate>::index_error(y_axis, _y(ix), "y");
+                  }
+                  indexes_.row(ix).setZero();
+                  weights_.row(ix).setConstant(
+                      std::numeric_limits<Coordinate>::quiet_NaN());
+                }
+              }
+            } catch (...) {
+              except = std::current_exception();
+            }
+          },
+          x_values.size(), num_threads);
+    });
+
+    if (except != nullptr) {
+      std::rethrow_exception(except);
+    }
+  }
+
+  /// Creates the plan from the indexes and weights calculated.
+  ///
+  /// @param x X-Axis of the grids
+  /// @param y Y-Axis of the grids
+  /// @param shape Shape of the arrays of points
+  /// @param indexes Indexes of the cells containing the points
+  /// @param weights Weights of the values of the cells
+  BivariatePlan(std::shared_ptr<Axis<double>> x,
+                std::shared_ptr<Axis<double>> y, Shape shape, Indexes indexes,
+                Weights weights)
+      : x_(std::move(x)),
+        y_(std::move(y)),
+        shape_(std::move(shape)),
+        indexes_(std::move(indexes)),
+        weights_(std::move(weights)) {
+    if (indexes_.rows() != weights_.rows()) {
+      throw std::invalid_argument(
+          "indexes and weights must have the same number of rows");
+    }
+    if (shape_size(shape_) != indexes_.rows()) {
+      throw std::invalid_argument(
+          "the shape does not match the number of points");
+    }
+    check_indexes(0, *x_);
+    check_indexes(2, *y_);
+  }
+
+  /// Gets the X-Axis
+  [[nodiscard]] inline auto x() const noexcept
+      -> std::shared_ptr<Axis<double>> {
+    return x_;
+  }
+
+  /// Gets the Y-Axis
+  [[nodiscard]] inline auto y() const noexcept
+      -> std::shared_ptr<Axis<double>> {
+    return y_;
+  }
+
+  /// Gets the number of points interpolated
+  [[nodiscard]] inline auto size() const noexcept -> int64_t {
+    return indexes_.rows();
+  }
+
+  /// Gets the shape of the arrays of points interpolated
+  [[nodiscard]] inline auto shape() const noexcept -> const Shape& {
+    return shape_;
+  }
+
+  /// Interpolates the grid at the points of the plan.
+  ///
+  /// @param grid Grid containing the values to be interpolated
+  /// @param num_threads The number of threads to use for the computation.
+  /// @param out Buffer provided by the caller to store the values
+  /// @return Values interpolated
+  template <typename Type>
+  auto apply(const Grid2D<Type>& grid, const size_t num_threads,
+             const Output& out = std::nullopt) const
+      -> pybind11::array_t<Coordinate> {
+    check_axis(*grid.x(), *x_, "x");
+    check_axis(*grid.y(), *y_, "y");
+
+    auto result = output_array<Coordinate>(out, shape_);
+    auto* _result = result.mutable_data();
+    {
+      pybind11::gil_scoped_release release;
+
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              _result[ix] = evaluate(grid, ix);
+            }
+          },
+          size(), num_threads);
+    }
+    return result;
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    return pybind11::make_tuple(x_->getstate(), y_->getstate(), shape_,
+                                indexes_, weights_);
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> BivariatePlan {
+    if (tuple.size() != 5) {
+      throw std::runtime_error("invalid state");
+    }
+    return BivariatePlan(
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[0].cast<pybind11::tuple>())),
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[1].cast<pybind11::tuple>())),
+        tuple[2].cast<Shape>(), tuple[3].cast<Indexes>(),
+        tuple[4].cast<Weights>());
+  }
+
+ protected:
+  std::shared_ptr<Axis<double>> x_;
+  std::shared_ptr<Axis<double>> y_;
+  Shape shape_;
+  Indexes indexes_;
+  Weights weights_;
+
+  /// Allocates the plan of the points of the given shape.
+  BivariatePlan(std::shared_ptr<Axis<double>> x,
+                std::shared_ptr<Axis<double>> y, Shape shape)
+      : x_(std::move(x)),
+        y_(std::move(y)),
+        shape_(std::move(shape)),
+        indexes_(shape_size(shape_), 4),
+        weights_(shape_size(shape_), 4) {}
+
+  /// Gets the number of points of the given shape
+  static auto shape_size(const Shape& shape) -> int64_t {
+    return std::accumulate(shape.begin(), shape.end(), int64_t(1),
+                           std::multiplies<int64_t>());
+  }
+
+  /// Interpolates the values of the grid for the indexes of the Z-Axis (and
+  /// U-Axis) given, at the point of index ix.
+  template <typename Grid, typename... Index>
+  inline auto evaluate(const Grid& grid, const size_t ix,
+                       Index&&... index) const noexcept -> Coordinate {
+    const auto* indexes = indexes_.row(ix).data();
+    const auto* weights = weights_.row(ix).data();
+    return weights[0] * static_cast<Coordinate>(
+                            grid.value(indexes[0], indexes[2], index...)) +
+           weights[1] * static_cast<Coordinate>(
+                            grid.value(indexes[0], indexes[3], index...)) +
+           weights[2] * static_cast<Coordinate>(
+                            grid.value(indexes[1], indexes[2], index...)) +
+           weights[3] * static_cast<Coordinate>(
+                            grid.value(indexes[1], indexes[3], index...));
+  }
+
+  /// Checks that the grid interpolated is defined by the axis used to create
+  /// the plan.
+  template <typename AxisType>
+  static void check_axis(const Axis<AxisType>& grid,
+                         const Axis<AxisType>& plan,
+                         const std::string& axis_label) {
+    if (grid != plan) {
+      throw std::invalid_argument(
+          "the axis " + axis_label + " of the grid (" +
+          static_cast<std::string>(grid) +
+          ") does not match the axis of the plan (" +
+          static_cast<std::string>(plan) + ")");
+    }
+  }
+
+  /// Checks that the indexes restored of the column col and of the
+  /// following one are valid for the axis.
+  template <typename AxisType>
+  void check_indexes(const Eigen::Index col, const Axis<AxisType>& axis) {
+    if (indexes_.rows() != 0 &&
+        (indexes_.middleCols(col, 2).minCoeff() < 0 ||
+         indexes_.middleCols(col, 2).maxCoeff() >= axis.size())) {
+      throw std::invalid_argument("invalid state");
+    }
+  }
+};
+
+/// Interpolation of trivariate functions, sharing the same axes, at a fixed
+/// set of points.
+///
+/// @tparam Coordinate The type of data used by the interpolators.
+/// @tparam AxisType Type of data handled by the Z-Axis
+template <typename Coordinate, typename AxisType>
+class TrivariatePlan : public BivariatePlan<Coordinate> {
+ public:
+  /// Indexes (iz0, iz1) of the cells containing the points
+  using ZIndexes = Eigen::Matrix<int64_t, Eigen::Dynamic, 2, Eigen::RowMajor>;
+
+  /// Weights of the values z0 and z1
+  using ZWeights =
+      Eigen::Matrix<Coordinate, Eigen::Dynamic, 2, Eigen::RowMajor>;
+
+  /// Creates the plan interpolating the points with the given interpolator.
+  ///
+  /// @param x X-Axis of the grids
+  /// @param y Y-Axis of the grids
+  /// @param z Z-Axis of the grids
+  /// @param x_values X-coordinates of the points
+  /// @param y_values Y-coordinates of the points
+  /// @param z_values Z-coordinates of the points
+  /// @param interpolator Interpolator used
+  /// @param z_method Interpolation method used on the Z-Axis
+  /// @param bounds_error If true, an exception is thrown if a point is
+  /// located outside the grid.
+  /// @param num_threads The number of threads to use for the computation.
+  template <template <class> class Point>
+  TrivariatePlan(std::shared_ptr<Axis<double>> x,
+                 std::shared_ptr<Axis<double>> y,
+                 std::shared_ptr<Axis<AxisType>> z,
+                 const pybind11::array_t<Coordinate>& x_values,
+                 const pybind11::array_t<Coordinate>& y_values,
+                 const pybind11::array_t<AxisType>& z_values,
+                 const detail::math::Bivariate<Point, Coordinate>* interpolator,
+                 const std::optional<std::string>& z_method,
+                 const bool bounds_error, const size_t num_threads)
+      : BivariatePlan<Coordinate>(std::move(x), std::move(y),
+                                  shape_of(x_values)),
+        z_(std::move(z)),
+        z_indexes_(x_values.size(), 2),
+        z_weights_(x_values.size(), 2) {
+    detail::check_ndarray_shape("x", x_values, "y", y_values, "z", z_values);
+
+    auto method = z_method.value_or("linear");
+    auto z_interpolation_method =
+        detail::math::get_z_interpolation_method(interpolator, method);
+    // With the nearest method, a single value of the Z-Axis is used.
+    auto z_select = method == "nearest";
+
+    auto _x = FlatView<Coordinate>(x_values);
+    auto _y = FlatView<Coordinate>(y_values);
+    auto _z = FlatView<AxisType>(z_values);
+
+    pybind11::gil_scoped_release release;
+
+    // Captures the detected exceptions in the calculation function
+    // (only the last exception captured is kept)
+    auto except = std::exception_ptr(nullptr);
+
+    // Access to the shared pointer outside the loop to avoid data races
+    const auto& x_axis = *this->x_;
+    const auto& y_axis = *this->y_;
+    const auto& z_axis = *z_;
+
+    detail::visit_weights(interpolator, [&](const auto& impl,
+                                            const bool select) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            try {
+              for (size_t ix = start; ix < end; ++ix) {
+                auto x_indexes = x_axis.find_indexes(_x(ix));
+                auto y_indexes = y_axis.find_indexes(_y(ix));
+                auto z_indexes = z_axis.find_indexes(_z(ix));
+
+                if (x_indexes.has_value() && y_indexes.has_value() &&
+                    z_indexes.has_value()) {
+                  int64_t ix0;
+                  int64_t ix1;
+                  int64_t iy0;
+                  int64_t iy1;
+                  int64_t iz0;
+                  int64_t iz1;
+
+                  std::tie(ix0, ix1) = *x_indexes;
+                  std::tie(iy0, iy1) = *y_indexes;
+                  std::tie(iz0, iz1) = *z_indexes;
+
+                  auto x0 = x_axis(ix0);
+                  auto x1 = x_axis(ix1);
+                  auto xi = _x(ix);
+                  if (x_axis.is_angle()) {
+                    xi = detail::math::normalize_angle(xi, x0, 360.0);
+                    x1 = detail::math::normalize_angle(x1, x0, 360.0);
+                  }
+
+                  auto weights = impl.weights(
+                      Point<Coordinate>(xi, _y(ix), _z(ix)),
+                      Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0)),
+                      Point<Coordinate>(x1, y_axis(iy1), z_axis(iz1)));
+                  if (select) {
+                    detail::math::select_point(weights, ix0, ix1, iy0, iy1);
+                  }
+                  this->indexes_.row(ix) << ix0, ix1, iy0, iy1;
+                  this->weights_.row(ix) = weights.transpose();
+
+                  // The function interpolating along the Z-Axis is linear
+                  // with respect to the values z0 and z1.
+                  auto w0 = z_interpolation_method(
+                      _z(ix), z_axis(iz0), z_axis(iz1), Coordinate(1),
+                      Coordinate(0));
+                  auto w1 = z_interpolation_method(
+                      _z(ix), z_axis(iz0), z_axis(iz1), Coordinate(0),
+                      Coordinate(1));
+                  if (z_select) {
+                    iz0 = iz1 = w0 == Coordinate(1) ? iz0 : iz1;
+                  }
+                  z_indexes_.row(ix) << iz0, iz1;
+                  z_weights_.row(ix) << w0, w1;
+                } else {
+                  if (bounds_error) {
+                    if (!x_indexes.has_value()) {
+                      Grid2D<Coordinate>::index_error(x_axis, _x(ix), "x");
+                    }
+                    if (!y_indexes.has_value()) {
+                      Grid2D<Coordinate>::index_error(y_axis, _y(ix), "y");
+                    }
+                    Grid2D<Coordinate>::index_error(z_axis, _z(ix), "z");
+                  }
+                  this->indexes_.row(ix).setZero();
+                  this->weights_.row(ix).setConstant(
+                      std::numeric_limits<Coordinate>::quiet_NaN());
+                  z_indexes_.row(ix).setZero();
+                  z_weights_.row(ix).setConstant(
+                      std::numeric_limits<Coordinate>::quiet_NaN());
+                }
+              }
+            } catch (...) {
+              except = std::current_exception();
+            }
+          },
+          x_values.size(), num_threads);
+    });
+
+    if (except != nullptr) {
+      std::rethrow_exception(except);
+    }
+  }
+
+  /// Creates the plan from the indexes and weights calculated.
+  TrivariatePlan(std::shared_ptr<Axis<double>> x,
+                 std::shared_ptr<Axis<double>> y,
+                 std::shared_ptr<Axis<AxisType>> z,
+                 typename BivariatePlan<Coordinate>::Shape shape,
+                 typename BivariatePlan<Coordinate>::Indexes indexes,
+                 typename BivariatePlan<Coordinate>::Weights weights,
+                 ZIndexes z_indexes, ZWeights z_weights)
+      : BivariatePlan<Coordinate>(std::move(x), std::move(y), std::move(shape),
+                                  std::move(indexes), std::move(weights)),
+        z_(std::move(z)),
+        z_indexes_(std::move(z_indexes)),
+        z_weights_(std::move(z_weights)) {
+    if (z_indexes_.rows() != this->size() ||
+        z_weights_.rows() != this->size()) {
+      throw std::invalid_argument(
+          "indexes and weights must have the same number of rows");
+    }
+    if (this->size() != 0 && (z_indexes_.minCoeff() < 0 ||
+                              z_indexes_.maxCoeff() >= z_->size())) {
+      throw std::invalid_argument("invalid state");
+    }
+  }
+
+  /// Gets the Z-Axis
+  [[nodiscard]] inline auto z() const noexcept
+      -> std::shared_ptr<Axis<AxisType>> {
+    return z_;
+  }
+
+  /// Interpolates the grid at the points of the plan.
+  ///
+  /// @param grid Grid containing the values to be interpolated
+  /// @param num_threads The number of threads to use for the computation.
+  /// @param out Buffer provided by the caller to store the values
+  /// @return Values interpolated
+  template <typename Type>
+  auto apply(const Grid3D<Type, AxisType>& grid, const size_t num_threads,
+             const Output& out = std::nullopt) const
+      -> pybind11::array_t<Coordinate> {
+    this->check_axis(*grid.x(), *this->x_, "x");
+    this->check_axis(*grid.y(), *this->y_, "y");
+    this->check_axis(*grid.z(), *z_, "z");
+
+    auto result = output_array<Coordinate>(out, this->shape_);
+    auto* _result = result.mutable_data();
+
+    // Snapshot of the grid: the values replaced by "update_array" or
+    // "update_slice" while the GIL is released are not seen by this
+    // calculation.
+    const auto snapshot = grid;
+
+    {
+      pybind11::gil_scoped_release release;
+
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            for (size_t ix = start; ix < end; ++ix) {
+              const auto* z_indexes = z_indexes_.row(ix).data();
+              const auto* z_weights = z_weights_.row(ix).data();
+              _result[ix] =
+                  z_weights[0] * this->evaluate(snapshot, ix, z_indexes[0]) +
+                  z_weights[1] * this->evaluate(snapshot, ix, z_indexes[1]);
+            }
+          },
+          this->size(), num_threads);
+    }
+    return result;
+  }
+
+  /// Pickle support: get state of this instance
+  [[nodiscard]] auto getstate() const -> pybind11::tuple {
+    return pybind11::make_tuple(this->x_->getstate(), this->y_->getstate(),
+                                z_->getstate(), this->shape_, this->indexes_,
+                                this->weights_, z_indexes_, z_weights_);
+  }
+
+  /// Pickle support: set state of this instance
+  static auto setstate(const pybind11::tuple& tuple) -> TrivariatePlan {
+    if (tuple.size() != 8) {
+      throw std::runtime_error("invalid state");
+    }
+    return TrivariatePlan(
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[0].cast<pybind11::tuple>())),
+        std::make_shared<Axis<double>>(
+            Axis<double>::setstate(tuple[1].cast<pybind11::tuple>())),
+        std::make_shared<Axis<AxisType>>(
+            Axis<AxisType>::setstate(tuple[2].cast<pybind11::tuple>())),
+        tuple[3].cast<typename BivariatePlan<Coordinate>::Shape>(),
+        tuple[4].cast<typename BivariatePlan<Coordinate>::Indexes>(),
+        tuple[5].cast<typename BivariatePlan<Coordinate>::Weights>(),
+        tuple[6].cast<ZIndexes>(), tuple[7].cast<ZWeights>());
+  }
+
+ private:
+  std::shared_ptr<Axis<AxisType>> z_;
+  ZIndexes z_indexes_;
+  ZWeights z_weights_;
+};
+
+}  // namespace pyinterp
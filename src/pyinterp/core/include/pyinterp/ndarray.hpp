@@ -0,0 +1,78 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace pyinterp {
+
+/// Returns the shape of an array.
+inline auto shape_of(const pybind11::array& array)
+    -> std::vector<pybind11::ssize_t> {
+  return {array.shape(), array.shape() + array.ndim()};
+}
+
+/// Read-only access to the items of an array of any shape and strides, by
+/// their index in the C order. The coordinates can thus be provided as N-D
+/// arrays, without being flattened into a copy.
+template <typename T>
+class FlatView {
+ public:
+  /// Default constructor
+  explicit FlatView(const pybind11::array_t<T>& array)
+      : data_(reinterpret_cast<const char*>(array.data())),
+        size_(array.size()) {
+    // The dimensions whose items follow each other in memory are merged, from
+    // the innermost dimension to the outermost.
+    for (auto ix = array.ndim() - 1; ix >= 0; --ix) {
+      auto extent = static_cast<int64_t>(array.shape(ix));
+      auto stride = static_cast<int64_t>(array.strides(ix));
+      if (extent == 1) {
+        continue;
+      }
+      if (!shape_.empty() && stride == strides_.back() * shape_.back()) {
+        shape_.back() *= extent;
+      } else {
+        shape_.push_back(extent);
+        strides_.push_back(stride);
+      }
+    }
+    if (shape_.size() <= 1) {
+      stride_ = strides_.empty() ? 0 : strides_[0];
+    }
+  }
+
+  /// Gets the number of items
+  [[nodiscard]] inline auto size() const noexcept -> int64_t { return size_; }
+
+  /// Gets the item at the index provided in the C order.
+  inline auto operator()(int64_t ix) const -> const T& {
+    if (!stride_.has_value()) {
+      auto offset = int64_t(0);
+      for (size_t dim = 0; dim < shape_.size(); ++dim) {
+        offset += (ix % shape_[dim]) * strides_[dim];
+        ix /= shape_[dim];
+      }
+      return *reinterpret_cast<const T*>(data_ + offset);
+    }
+    return *reinterpret_cast<const T*>(data_ + ix * *stride_);
+  }
+
+ private:
+  /// Address of the first item
+  const char* data_;
+  /// Number of items
+  int64_t size_;
+  /// Number of bytes between two consecutive items, if the items are evenly
+  /// spaced in memory.
+  std::optional<int64_t> stride_{};
+  /// Shape and strides of the merged dimensions, from the innermost
+  std::vector<int64_t> shape_{};
+  std::vector<int64_t> strides_{};
+};
+
+}  // namespace pyinterp
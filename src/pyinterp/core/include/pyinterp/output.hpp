@@ -0,0 +1,73 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pyinterp/detail/broadcast.hpp"
+
+namespace pyinterp {
+
+/// Buffer provided by the caller to store the results of a calculation.
+using Output = std::optional<pybind11::array>;
+
+/// Buffers provided by the caller to store the two arrays of results of a
+/// calculation.
+using OutputPair = std::optional<std::pair<pybind11::array, pybind11::array>>;
+
+/// Returns the buffer provided by the caller to store the Ith array of
+/// results of a calculation.
+template <size_t I>
+inline auto output_item(const OutputPair& out) -> Output {
+  return out.has_value() ? Output(std::get<I>(*out)) : std::nullopt;
+}
+
+/// Returns the array storing the results of a calculation: the buffer
+/// provided by the caller, after checking that it can receive the results,
+/// otherwise a new array.
+///
+/// The buffer must be a writable, C-contiguous, array of the type and shape
+/// of the results. It is not converted: the results would be written into a
+/// copy of the buffer.
+///
+/// @param out Buffer provided by the caller
+/// @param shape Shape of the results
+/// @param name Name of the parameter providing the buffer
+template <typename T>
+auto output_array(const Output& out,
+                  const std::vector<pybind11::ssize_t>& shape,
+                  const std::string& name = "out") -> pybind11::array_t<T> {
+  if (!out.has_value()) {
+    return pybind11::array_t<T>(pybind11::array::ShapeContainer(shape));
+  }
+  const auto& array = *out;
+  if (!pybind11::isinstance<pybind11::array_t<T>>(array)) {
+    throw std::invalid_argument(
+        name + " must be an array of type " +
+        static_cast<std::string>(pybind11::str(pybind11::dtype::of<T>())));
+  }
+  auto match = array.ndim() == static_cast<pybind11::ssize_t>(shape.size());
+  for (auto ix = 0; match && ix < array.ndim(); ++ix) {
+    match = array.shape(ix) == shape[ix];
+  }
+  if (!match) {
+    throw std::invalid_argument(name + " has shape " +
+                                detail::ndarray_shape(array) +
+                                ", expected shape " +
+                                detail::shape_string(shape));
+  }
+  if ((array.flags() & pybind11::array::c_style) == 0) {
+    throw std::invalid_argument(name + " must be a C-contiguous array");
+  }
+  if (!array.writeable()) {
+    throw std::invalid_argument(name + " must be a writable array");
+  }
+  return pybind11::reinterpret_borrow<pybind11::array_t<T>>(array);
+}
+
+}  // namespace pyinterp
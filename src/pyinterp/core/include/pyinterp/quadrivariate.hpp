@@ -6,13 +6,17 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include <array>
 #include <cctype>
+#include <type_traits>
 
 #include "pyinterp/bivariate.hpp"
 #include "pyinterp/detail/geometry/point.hpp"
 #include "pyinterp/detail/math/trivariate.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/grid.hpp"
+#include "pyinterp/ndarray.hpp"
+#include "pyinterp/output.hpp"
 
 namespace pyinterp {
 
@@ -49,25 +53,32 @@ auto quadrivariate(const Grid4D<Type, AxisType>& grid,
                    const Bivariate4D<Point, Coordinate>* interpolator,
                    const std::optional<std::string>& z_method,
                    const std::optional<std::string>& u_method,
-                   const bool bounds_error, const size_t num_threads)
+                   const bool bounds_error, const size_t num_threads,
+                   const Output& out = std::nullopt)
     -> pybind11::array_t<Coordinate> {
-  pyinterp::detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z, "u", 1,
-                                     u);
   pyinterp::detail::check_ndarray_shape("x", x, "y", y, "z", z, "u", u);
   auto z_interpolation_method =
       pyinterp::detail::math::get_z_interpolation_method(
           interpolator, z_method.value_or("linear"));
   auto u_interpolation_method =
       get_u_interpolation_method<Coordinate>(u_method.value_or("linear"));
+  // With the nearest methods, only the planes of the Z-Axis and the U-Axis
+  // nearest to the point are interpolated.
+  auto z_select = z_method.value_or("linear") == "nearest";
+  auto u_select = u_method.value_or("linear") == "nearest";
 
   auto size = x.size();
-  auto result =
-      pybind11::array_t<Coordinate>(pybind11::array::ShapeContainer{size});
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
-  auto _u = u.template unchecked<1>();
-  auto _result = result.template mutable_unchecked<1>();
+  auto result = output_array<Coordinate>(out, shape_of(x));
+  auto _x = FlatView<Coordinate>(x);
+  auto _y = FlatView<Coordinate>(y);
+  auto _z = FlatView<AxisType>(z);
+  auto _u = FlatView<Coordinate>(u);
+  auto* _result = result.mutable_data();
+
+  // Snapshot of the grid: the values replaced by "update_array" or
+  // "update_slice" while the GIL is released are not seen by this
+  // calculation.
+  const auto snapshot = grid;
 
   {
     pybind11::gil_scoped_release release;
@@ -77,96 +88,150 @@ auto quadrivariate(const Grid4D<Type, AxisType>& grid,
     auto except = std::exception_ptr(nullptr);
 
     // Access to the shared pointer outside the loop to avoid data races
-    const auto& x_axis = *grid.x();
-    const auto& y_axis = *grid.y();
-    const auto& z_axis = *grid.z();
-    const auto& u_axis = *grid.u();
-
-    detail::dispatch(
-        [&](size_t start, size_t end) {
-          try {
-            for (size_t ix = start; ix < end; ++ix) {
-              auto x_indexes = x_axis.find_indexes(_x(ix));
-              auto y_indexes = y_axis.find_indexes(_y(ix));
-              auto z_indexes = z_axis.find_indexes(_z(ix));
-              auto u_indexes = u_axis.find_indexes(_u(ix));
-
-              if (x_indexes.has_value() && y_indexes.has_value() &&
-                  z_indexes.has_value() && u_indexes.has_value()) {
-                int64_t ix0;
-                int64_t ix1;
-                int64_t iy0;
-                int64_t iy1;
-                int64_t iz0;
-                int64_t iz1;
-                int64_t iu0;
-                int64_t iu1;
-
-                std::tie(ix0, ix1) = *x_indexes;
-                std::tie(iy0, iy1) = *y_indexes;
-                std::tie(iz0, iz1) = *z_indexes;
-                std::tie(iu0, iu1) = *u_indexes;
-
-                auto x0 = x_axis(ix0);
-
-                // The fourth coordinate is not used by the 3D interpolator.
-                auto p = Point<Coordinate>(
-                    x_axis.is_angle()
-                        ? detail::math::normalize_angle(_x(ix), x0, 360.0)
-                        : _x(ix),
-                    _y(ix), _z(ix));
-                auto p0 = Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0));
-                auto p1 =
-                    Point<Coordinate>(x_axis(ix1), y_axis(iy1), z_axis(iz1));
-
-                auto u0 = pyinterp::detail::math::trivariate<Point, Coordinate>(
-                    p, p0, p1,
-                    static_cast<Coordinate>(grid.value(ix0, iy0, iz0, iu0)),
-                    static_cast<Coordinate>(grid.value(ix0, iy1, iz0, iu0)),
-                    static_cast<Coordinate>(grid.value(ix1, iy0, iz0, iu0)),
-                    static_cast<Coordinate>(grid.value(ix1, iy1, iz0, iu0)),
-                    static_cast<Coordinate>(grid.value(ix0, iy0, iz1, iu0)),
-                    static_cast<Coordinate>(grid.value(ix0, iy1, iz1, iu0)),
-                    static_cast<Coordinate>(grid.value(ix1, iy0, iz1, iu0)),
-                    static_cast<Coordinate>(grid.value(ix1, iy1, iz1, iu0)),
-                    interpolator, z_interpolation_method);
-
-                auto u1 = pyinterp::detail::math::trivariate<Point, Coordinate>(
-                    p, p0, p1,
-                    static_cast<Coordinate>(grid.value(ix0, iy0, iz0, iu1)),
-                    static_cast<Coordinate>(grid.value(ix0, iy1, iz0, iu1)),
-                    static_cast<Coordinate>(grid.value(ix1, iy0, iz0, iu1)),
-                    static_cast<Coordinate>(grid.value(ix1, iy1, iz0, iu1)),
-                    static_cast<Coordinate>(grid.value(ix0, iy0, iz1, iu1)),
-                    static_cast<Coordinate>(grid.value(ix0, iy1, iz1, iu1)),
-                    static_cast<Coordinate>(grid.value(ix1, iy0, iz1, iu1)),
-                    static_cast<Coordinate>(grid.value(ix1, iy1, iz1, iu1)),
-                    interpolator, z_interpolation_method);
-
-                _result(ix) = u_interpolation_method(_u(ix), u_axis(iu0),
-                                                     u_axis(iu1), u0, u1);
-
-              } else {
-                if (bounds_error) {
-                  if (!x_indexes.has_value()) {
-                    Grid4D<Type, AxisType>::index_error(x_axis, _x(ix), "x");
+    const auto& x_axis = *snapshot.x();
+    const auto& y_axis = *snapshot.y();
+    const auto& z_axis = *snapshot.z();
+    const auto& u_axis = *snapshot.u();
+
+    // The loop is instantiated for the concrete type of the interpolator:
+    // its weights are calculated once per point and applied to the values
+    // of all the planes (z, u) interpolated.
+    detail::math::visit(interpolator, [&](const auto& impl) {
+      detail::dispatch(
+          [&](size_t start, size_t end) {
+            try {
+              // Value of the grid, in the precision of the calculation
+              auto q = [&](const int64_t i, const int64_t j, const int64_t k,
+                           const int64_t l) -> Coordinate {
+                return static_cast<Coordinate>(snapshot.value(i, j, k, l));
+              };
+              auto z_search = detail::AxisSearch<AxisType>(z_axis);
+              auto u_search = detail::AxisSearch<double>(u_axis);
+
+              for (size_t ix = start; ix < end; ++ix) {
+                auto x_indexes = x_axis.find_indexes(_x(ix));
+                auto y_indexes = y_axis.find_indexes(_y(ix));
+                auto z_indexes = z_search.find_indexes(_z(ix));
+                auto u_indexes = u_search.find_indexes(_u(ix));
+
+                if (x_indexes.has_value() && y_indexes.has_value() &&
+                    z_indexes.has_value() && u_indexes.has_value()) {
+                  int64_t ix0;
+                  int64_t ix1;
+                  int64_t iy0;
+                  int64_t iy1;
+                  int64_t iz0;
+                  int64_t iz1;
+                  int64_t iu0;
+                  int64_t iu1;
+
+                  std::tie(ix0, ix1) = *x_indexes;
+                  std::tie(iy0, iy1) = *y_indexes;
+                  std::tie(iz0, iz1) = *z_indexes;
+                  std::tie(iu0, iu1) = *u_indexes;
+
+                  auto x0 = x_axis(ix0);
+                  auto x1 = x_axis(ix1);
+                  auto xi = static_cast<double>(_x(ix));
+                  if (x_axis.is_angle()) {
+                    xi = detail::math::normalize_angle(xi, x0, 360.0);
+                    x1 = detail::math::normalize_angle(x1, x0, 360.0);
                   }
-                  if (!y_indexes.has_value()) {
-                    Grid4D<Type, AxisType>::index_error(y_axis, _y(ix), "y");
+
+                  // The fourth coordinate is not used by the 3D interpolator.
+                  auto p = Point<Coordinate>(xi, _y(ix), _z(ix));
+                  auto p0 = Point<Coordinate>(x0, y_axis(iy0), z_axis(iz0));
+                  auto p1 = Point<Coordinate>(x1, y_axis(iy1), z_axis(iz1));
+                  auto z = detail::math::z_coordinate<Point, Coordinate>(p);
+                  auto z0 = detail::math::z_coordinate<Point, Coordinate>(p0);
+                  auto z1 = detail::math::z_coordinate<Point, Coordinate>(p1);
+
+                  // Interpolates the planes defined by the indexes iz of the
+                  // Z-Axis and iu of the U-Axis. The values are returned in
+                  // the order (z0, u0), (z1, u0), (z0, u1), (z1, u1).
+                  auto planes = [&](const auto& iz, const auto& iu) {
+                    constexpr auto nz =
+                        std::tuple_size_v<std::decay_t<decltype(iz)>>;
+                    constexpr auto nu =
+                        std::tuple_size_v<std::decay_t<decltype(iu)>>;
+                    return detail::math::evaluate_planes<Point>(
+                        impl, p, p0, p1, ix0, ix1, iy0, iy1,
+                        [&](int64_t i0, int64_t i1, int64_t j0, int64_t j1) {
+                          auto result =
+                              Eigen::Matrix<Coordinate, 4, nz * nu>();
+                          for (size_t ku = 0; ku < nu; ++ku) {
+                            for (size_t kz = 0; kz < nz; ++kz) {
+                              auto k = iz[kz];
+                              auto l = iu[ku];
+                              result.col(ku * nz + kz) << q(i0, j0, k, l),
+                                  q(i0, j1, k, l), q(i1, j0, k, l),
+                                  q(i1, j1, k, l);
+                            }
+                          }
+                          return result;
+                        });
+                  };
+
+                  auto u = _u(ix);
+                  auto u0 = static_cast<Coordinate>(u_axis(iu0));
+                  auto u1 = static_cast<Coordinate>(u_axis(iu1));
+
+                  if (z_select) {
+                    iz0 = detail::math::nearest(z, z0, z1, iz0, iz1);
+                  }
+                  if (u_select) {
+                    iu0 = detail::math::nearest(u, u0, u1, iu0, iu1);
                   }
-                  if (!z_indexes.has_value()) {
-                    Grid4D<Type, AxisType>::index_error(z_axis, _z(ix), "z");
+
+                  if (z_select && u_select) {
+                    _result[ix] = planes(std::array<int64_t, 1>{iz0},
+                                         std::array<int64_t, 1>{iu0})(0);
+                  } else if (z_select) {
+                    auto values = planes(std::array<int64_t, 1>{iz0},
+                                         std::array<int64_t, 2>{iu0, iu1});
+                    _result[ix] = u_interpolation_method(u, u0, u1, values(0),
+                                                         values(1));
+                  } else if (u_select) {
+                    auto values = planes(std::array<int64_t, 2>{iz0, iz1},
+                                         std::array<int64_t, 1>{iu0});
+                    _result[ix] = z_interpolation_method(z, z0, z1, values(0),
+                                                         values(1));
+                  } else {
+                    auto values = planes(std::array<int64_t, 2>{iz0, iz1},
+                                         std::array<int64_t, 2>{iu0, iu1});
+                    _result[ix] = u_interpolation_method(
+                        u, u0, u1,
+                        z_interpolation_method(z, z0, z1, values(0),
+                                               values(1)),
+                        z_interpolation_method(z, z0, z1, values(2),
+                                               values(3)));
                   }
-                  Grid4D<Type, AxisType>::index_error(u_axis, _u(ix), "u");
+
+                } else {
+                  if (bounds_error) {
+                    if (!x_indexes.has_value()) {
+                      Grid4D<Type, AxisType>::index_error(x_axis, _x(ix),
+                                                          "x");
+                    }
+                    if (!y_indexes.has_value()) {
+                      Grid4D<Type, AxisType>::index_error(y_axis, _y(ix),
+                                                          "y");
+                    }
+                    if (!z_indexes.has_value()) {
+                      Grid4D<Type, AxisType>::index_error(z_axis, _z(ix),
+                                                          "z");
+                    }
+                    Grid4D<Type, AxisType>::index_error(u_axis, _u(ix), "u");
+                  }
+                  _result[ix] = std::numeric_limits<Coordinate>::quiet_NaN();
                 }
-                _result(ix) = std::numeric_limits<Coordinate>::quiet_NaN();
               }
+            } catch (...) {
+              except = std::current_exception();
             }
-          } catch (...) {
-            except = std::current_exception();
-          }
-        },
-        size, num_threads);
+          },
+          size, num_threads);
+    });
 
     if (except != nullptr) {
       std::rethrow_exception(except);
@@ -175,6 +240,39 @@ auto quadrivariate(const Grid4D<Type, AxisType>& grid,
   return result;
 }
 
+/// Interpolation of a quadrivariate function in single precision: the X, Y
+/// and U coordinates are float32, the calculations are done in single
+/// precision and the values interpolated are returned as float32.
+///
+/// @tparam Point A type of point defining a point in space.
+/// @tparam AxisType Axis data type
+/// @tparam Type Grid data type
+template <template <class> class Point, typename AxisType, typename Type>
+auto quadrivariate_single(const Grid4D<Type, AxisType>& grid,
+                          const pybind11::array_t<float>& x,
+                          const pybind11::array_t<float>& y,
+                          const pybind11::array_t<AxisType>& z,
+                          const pybind11::array_t<float>& u,
+                          const Bivariate4D<Point, double>* interpolator,
+                          const std::optional<std::string>& z_method,
+                          const std::optional<std::string>& u_method,
+                          const bool bounds_error, const size_t num_threads,
+                          const Output& out = std::nullopt)
+    -> pybind11::array_t<float> {
+  auto impl = single_precision(interpolator);
+  if (impl != nullptr) {
+    return quadrivariate<Point, float, AxisType, Type>(
+        grid, x, y, z, u, impl.get(), z_method, u_method, bounds_error,
+        num_threads, out);
+  }
+  return narrow(quadrivariate<Point, double, AxisType, Type>(
+                    grid, pybind11::array_t<double>::ensure(x),
+                    pybind11::array_t<double>::ensure(y), z,
+                    pybind11::array_t<double>::ensure(u), interpolator,
+                    z_method, u_method, bounds_error, num_threads),
+                out);
+}
+
 /// Implementations of quadrivariate function.
 ///
 /// @tparam Point A type of point defining a point in space.
@@ -194,6 +292,7 @@ void implement_quadrivariate(pybind11::module& m, const std::string& prefix,
         pybind11::arg("z_method") = pybind11::none(),
         pybind11::arg("u_method") = pybind11::none(),
         pybind11::arg("bounds_error") = false, pybind11::arg("num_threads") = 0,
+        pybind11::arg("out") = pybind11::none(),
         (R"__doc__(
 Interpolate the values provided on the defined trivariate function.
 
@@ -222,10 +321,33 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result. It must not overlap the coordinates.
 Return:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates.
 )__doc__")
             .c_str());
+
+  if constexpr (std::is_same_v<Type, float>) {
+    m.def(("quadrivariate_single_" + function_suffix).c_str(),
+          &quadrivariate_single<Point, AxisType, Type>, pybind11::arg("grid"),
+          pybind11::arg("x"), pybind11::arg("y"), pybind11::arg("z"),
+          pybind11::arg("u"), pybind11::arg("interpolator"),
+          pybind11::arg("z_method") = pybind11::none(),
+          pybind11::arg("u_method") = pybind11::none(),
+          pybind11::arg("bounds_error") = false,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("out") = pybind11::none(),
+          R"__doc__(
+Interpolate the values provided on the defined quadrivariate function, in
+single precision: the X, Y and U coordinates are converted to float32, and
+the calculations are done, and the values interpolated are returned, in
+float32. The arguments are those of
+:py:func:`pyinterp.core.quadrivariate_float32`.
+)__doc__");
+  }
 }
 
 }  // namespace pyinterp
@@ -12,6 +12,7 @@
 #include "pyinterp/detail/geodetic/system.hpp"
 #include "pyinterp/detail/thread.hpp"
 #include "pyinterp/geodetic/system.hpp"
+#include "pyinterp/output.hpp"
 
 namespace pyinterp {
 
@@ -156,16 +157,16 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   /// Search for the nearest K nearest neighbors of a given coordinates.
   auto query(const pybind11::array_t<CoordinateType, pybind11::array::c_style>
                  &coordinates,
-             const uint32_t k, const bool within,
-             const size_t num_threads) const -> pybind11::tuple {
+             const uint32_t k, const bool within, const size_t num_threads,
+             const OutputPair &out = std::nullopt) const -> pybind11::tuple {
     detail::check_array_ndim("coordinates", 2, coordinates);
     switch (coordinates.shape(1)) {
       case N - 1:
         return _query<N - 1>(&RTree<CoordinateType, Type, N>::from_lon_lat,
-                             coordinates, k, within, num_threads);
+                             coordinates, k, within, num_threads, out);
       case N:
         return _query<N>(&RTree<CoordinateType, Type, N>::from_lon_lat,
-                         coordinates, k, within, num_threads);
+                         coordinates, k, within, num_threads, out);
       default:
         throw std::invalid_argument(
             RTree<CoordinateType, Type, N>::invalid_shape());
@@ -177,8 +178,8 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
       const pybind11::array_t<CoordinateType, pybind11::array::c_style>
           &coordinates,
       const std::optional<distance_t> &radius, const uint32_t k,
-      const uint32_t p, const bool within, const size_t num_threads) const
-      -> pybind11::tuple {
+      const uint32_t p, const bool within, const size_t num_threads,
+      const OutputPair &out = std::nullopt) const -> pybind11::tuple {
     detail::check_array_ndim("coordinates", 2, coordinates);
 
     switch (coordinates.shape(1)) {
@@ -186,12 +187,12 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
         return _inverse_distance_weighting<N - 1>(
             &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates,
             radius.value_or(std::numeric_limits<distance_t>::max()), k, p,
-            within, num_threads);
+            within, num_threads, out);
       case N:
         return _inverse_distance_weighting<N>(
             &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates,
             radius.value_or(std::numeric_limits<distance_t>::max()), k, p,
-            within, num_threads);
+            within, num_threads, out);
       default:
         throw std::invalid_argument(
             RTree<CoordinateType, Type, N>::invalid_shape());
@@ -204,8 +205,8 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
           &coordinates,
       const std::optional<distance_t> &radius, const uint32_t k,
       const RadialBasisFunction rbf, const std::optional<promotion_t> &epsilon,
-      const promotion_t smooth, const bool within,
-      const size_t num_threads) const -> pybind11::tuple {
+      const promotion_t smooth, const bool within, const size_t num_threads,
+      const OutputPair &out = std::nullopt) const -> pybind11::tuple {
     detail::check_array_ndim("coordinates", 2, coordinates);
     switch (coordinates.shape(1)) {
       case N - 1:
@@ -213,13 +214,13 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
             &RTree<CoordinateType, Type, N>::from_lon_lat, coordinates,
             radius.value_or(std::numeric_limits<distance_t>::max()), k, rbf,
             epsilon.value_or(std::numeric_limits<promotion_t>::quiet_NaN()),
-            smooth, within, num_threads);
+            smooth, within, num_threads, out);
       case N:
         return _rbf<N>(
             &RTree<CoordinateType, Type, N>::from_lon_lat_alt, coordinates,
             radius.value_or(std::numeric_limits<distance_t>::max()), k, rbf,
             epsilon.value_or(std::numeric_limits<promotion_t>::quiet_NaN()),
-            smooth, within, num_threads);
+            smooth, within, num_threads, out);
       default:
         throw std::invalid_argument(
             RTree<CoordinateType, Type, N>::invalid_shape());
@@ -397,8 +398,8 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   template <size_t M>
   auto _query(Converter converter,
               const pybind11::array_t<CoordinateType> &coordinates,
-              const uint32_t k, const bool within,
-              const size_t num_threads) const -> pybind11::tuple {
+              const uint32_t k, const bool within, const size_t num_threads,
+              const OutputPair &out) const -> pybind11::tuple {
     Requester requester =
         within ? &detail::geometry::RTree<CoordinateType, Type, N>::query_within
                : &detail::geometry::RTree<CoordinateType, Type, N>::query;
@@ -407,10 +408,10 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
     auto size = coordinates.shape(0);
 
     // Allocation of result matrices.
-    auto distance = pybind11::array_t<distance_t>(
-        pybind11::array::ShapeContainer{size, static_cast<ssize_t>(k)});
-    auto value = pybind11::array_t<Type>(
-        pybind11::array::ShapeContainer{size, static_cast<ssize_t>(k)});
+    auto distance = output_array<distance_t>(
+        output_item<0>(out), {size, static_cast<ssize_t>(k)}, "out[0]");
+    auto value = output_array<Type>(
+        output_item<1>(out), {size, static_cast<ssize_t>(k)}, "out[1]");
 
     auto _distance = distance.template mutable_unchecked<2>();
     auto _value = value.template mutable_unchecked<2>();
@@ -466,15 +467,15 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
   auto _inverse_distance_weighting(
       Converter converter, const pybind11::array_t<CoordinateType> &coordinates,
       const distance_t radius, const uint32_t k, const uint32_t p,
-      const bool within, const size_t num_threads) const -> pybind11::tuple {
+      const bool within, const size_t num_threads,
+      const OutputPair &out) const -> pybind11::tuple {
     auto _coordinates = coordinates.template unchecked<2>();
     auto size = coordinates.shape(0);
 
     // Allocation of result vectors.
-    auto data =
-        pybind11::array_t<distance_t>(pybind11::array::ShapeContainer{size});
+    auto data = output_array<distance_t>(output_item<0>(out), {size}, "out[0]");
     auto neighbors =
-        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+        output_array<uint32_t>(output_item<1>(out), {size}, "out[1]");
 
     auto _data = data.template mutable_unchecked<1>();
     auto _neighbors = neighbors.template mutable_unchecked<1>();
@@ -522,7 +523,8 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
             const distance_t radius, const uint32_t k,
             const RadialBasisFunction rbf, const promotion_t epsilon,
             const promotion_t smooth, const bool within,
-            const size_t num_threads) const -> pybind11::tuple {
+            const size_t num_threads,
+            const OutputPair &out) const -> pybind11::tuple {
     auto _coordinates = coordinates.template unchecked<2>();
     auto size = coordinates.shape(0);
 
@@ -531,9 +533,9 @@ class RTree : public detail::geometry::RTree<CoordinateType, Type, N> {
 
     // Allocation of result vectors.
     auto data =
-        pybind11::array_t<promotion_t>(pybind11::array::ShapeContainer{size});
+        output_array<promotion_t>(output_item<0>(out), {size}, "out[0]");
     auto neighbors =
-        pybind11::array_t<uint32_t>(pybind11::array::ShapeContainer{size});
+        output_array<uint32_t>(output_item<1>(out), {size}, "out[1]");
 
     auto _data = data.template mutable_unchecked<1>();
     auto _neighbors = neighbors.template mutable_unchecked<1>();
@@ -0,0 +1,158 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#pragma once
+#include <pybind11/numpy.h>
+#include <utility>
+#include <vector>
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/spatial_sort.hpp"
+#include "pyinterp/detail/thread.hpp"
+#include "pyinterp/ndarray.hpp"
+#include "pyinterp/output.hpp"
+
+namespace pyinterp {
+
+/// Calculates the order in which the points must be processed so that the
+/// points close on the grid are interpolated one after the other: the points
+/// are sorted by the Morton code of their position on the grid.
+///
+/// @param x_axis X-Axis of the grid
+/// @param x X-coordinates of the points
+/// @param y_axis Y-Axis of the grid
+/// @param y Y-coordinates of the points
+/// @param num_threads The number of threads to use for the computation
+/// @return The indexes of the points in the order of processing
+template <typename Coordinate>
+auto spatial_order(const detail::Axis<double>& x_axis,
+                   const pybind11::array_t<Coordinate>& x,
+                   const detail::Axis<double>& y_axis,
+                   const pybind11::array_t<Coordinate>& y,
+                   const size_t num_threads) -> std::vector<int64_t> {
+  auto _x = FlatView<Coordinate>(x);
+  auto _y = FlatView<Coordinate>(y);
+  auto keys = std::vector<uint64_t>(x.size());
+  auto order = std::vector<int64_t>();
+  {
+    pybind11::gil_scoped_release release;
+
+    const auto x_quantizer = detail::AxisQuantizer<double>(x_axis, 12);
+    const auto y_quantizer = detail::AxisQuantizer<double>(y_axis, 12);
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            keys[ix] =
+                detail::morton_key(x_quantizer(_x(ix)), y_quantizer(_y(ix)));
+          }
+        },
+        keys.size(), num_threads);
+    order = detail::argsort(std::move(keys), num_threads);
+  }
+  return order;
+}
+
+/// Calculates the order in which the points must be processed so that the
+/// points close on the grid are interpolated one after the other: the points
+/// are sorted by the Morton code of their position on the grid.
+///
+/// @param x_axis X-Axis of the grid
+/// @param x X-coordinates of the points
+/// @param y_axis Y-Axis of the grid
+/// @param y Y-coordinates of the points
+/// @param z_axis Z-Axis of the grid
+/// @param z Z-coordinates of the points
+/// @param num_threads The number of threads to use for the computation
+/// @return The indexes of the points in the order of processing
+template <typename Coordinate, typename AxisType>
+auto spatial_order(const detail::Axis<double>& x_axis,
+                   const pybind11::array_t<Coordinate>& x,
+                   const detail::Axis<double>& y_axis,
+                   const pybind11::array_t<Coordinate>& y,
+                   const detail::Axis<AxisType>& z_axis,
+                   const pybind11::array_t<AxisType>& z,
+                   const size_t num_threads) -> std::vector<int64_t> {
+  auto _x = FlatView<Coordinate>(x);
+  auto _y = FlatView<Coordinate>(y);
+  auto _z = FlatView<AxisType>(z);
+  auto keys = std::vector<uint64_t>(x.size());
+  auto order = std::vector<int64_t>();
+  {
+    pybind11::gil_scoped_release release;
+
+    const auto x_quantizer = detail::AxisQuantizer<double>(x_axis, 8);
+    const auto y_quantizer = detail::AxisQuantizer<double>(y_axis, 8);
+    const auto z_quantizer = detail::AxisQuantizer<AxisType>(z_axis, 8);
+
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            keys[ix] =
+                detail::morton_key(x_quantizer(_x(ix)), y_quantizer(_y(ix)),
+                                   z_quantizer(_z(ix)));
+          }
+        },
+        keys.size(), num_threads);
+    order = detail::argsort(std::move(keys), num_threads);
+  }
+  return order;
+}
+
+/// Returns the values sorted in the order given, as a vector.
+///
+/// @param values Values to sort
+/// @param order Indexes of the values in the expected order
+/// @param num_threads The number of threads to use for the computation
+template <typename T>
+auto gather(const pybind11::array_t<T>& values,
+            const std::vector<int64_t>& order, const size_t num_threads)
+    -> pybind11::array_t<T> {
+  auto result = pybind11::array_t<T>(
+      pybind11::array::ShapeContainer{static_cast<ssize_t>(order.size())});
+  auto _values = FlatView<T>(values);
+  auto _result = result.template mutable_unchecked<1>();
+  {
+    pybind11::gil_scoped_release release;
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            _result(ix) = _values(order[ix]);
+          }
+        },
+        order.size(), num_threads);
+  }
+  return result;
+}
+
+/// Moves the values calculated in the order given back to the original
+/// position of the points.
+///
+/// @param values Values calculated in the order given
+/// @param order Indexes of the points in the order of calculation
+/// @param shape Shape of the array of points
+/// @param num_threads The number of threads to use for the computation
+/// @param out Buffer provided by the caller to store the values moved
+template <typename T>
+auto scatter(const pybind11::array_t<T>& values,
+             const std::vector<int64_t>& order,
+             const std::vector<pybind11::ssize_t>& shape,
+             const size_t num_threads, const Output& out = std::nullopt)
+    -> pybind11::array_t<T> {
+  auto result = output_array<T>(out, shape);
+  auto _values = values.template unchecked<1>();
+  auto* _result = result.mutable_data();
+  {
+    pybind11::gil_scoped_release release;
+    detail::dispatch(
+        [&](size_t start, size_t end) {
+          for (size_t ix = start; ix < end; ++ix) {
+            _result[order[ix]] = _values(ix);
+          }
+        },
+        order.size(), num_threads);
+  }
+  return result;
+}
+
+}  // namespace pyinterp
@@ -4,7 +4,13 @@
 // BSD-style license that can be found in the LICENSE file.
 #include "pyinterp/detail/math/linear.hpp"
 #include "pyinterp/bicubic.hpp"
+#include "pyinterp/detail/math/bicubic_polynomial.hpp"
+#include "pyinterp/detail/math/bspline.hpp"
+#include "pyinterp/detail/math/cubic_convolution.hpp"
+#include "pyinterp/ndarray.hpp"
+#include "pyinterp/spatial_sort.hpp"
 #include <cctype>
+#include <type_traits>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
@@ -35,6 +41,39 @@ inline auto interp_type(const FittingModel kind) -> const gsl_interp_type* {
   }
 }
 
+/// Returns true if the fitting model is evaluated in closed form, as a
+/// weighted sum of the 4×4 nodes surrounding the point.
+inline auto is_closed_form(const FittingModel kind) -> bool {
+  return kind == kCubicConvolution || kind == kBSpline;
+}
+
+/// Returns true if the surface interpolated by the fitting model is a
+/// bicubic polynomial in each cell of the grid.
+inline auto is_bicubic_polynomial(const FittingModel kind) -> bool {
+  return kind == kLinear || kind == kCSpline || kind == kCSplinePeriodic ||
+         is_closed_form(kind);
+}
+
+/// Weights of the nodes surrounding the point located at t in its cell, for
+/// the fitting models evaluated in closed form.
+inline auto closed_form_weights(const FittingModel kind, const double t)
+    -> std::array<double, 4> {
+  return kind == kBSpline ? detail::math::bspline_weights(t)
+                          : detail::math::cubic_convolution_weights(t);
+}
+
+/// The fitting models evaluated in closed form weight the nodes by their
+/// rank: the X and Y axes of the grid must be regular.
+template <typename Grid>
+auto check_closed_form(const Grid& grid, const FittingModel kind) -> void {
+  if (is_closed_form(kind) &&
+      !(grid.x()->is_regular() && grid.y()->is_regular())) {
+    throw std::invalid_argument(
+        "The cubic convolution and the B-spline require regular X and Y "
+        "axes");
+  }
+}
+
 // Error thrown if it' s not possible to frame the value on the specified axis.
 template <typename T>
 auto index_error(const std::string& axis, const T value, const size_t n)
@@ -86,6 +125,299 @@ auto load_frame(const Grid2D<DataType>& grid, const double x, const double y,
   return frame.is_valid();
 }
 
+/// Cells of the axes framing the last point for which a frame was loaded:
+/// they define the window of the frame.
+struct FrameCell {
+  /// Cell of the X axis
+  std::optional<std::tuple<int64_t, int64_t>> x{};
+  /// Cell of the Y axis
+  std::optional<std::tuple<int64_t, int64_t>> y{};
+  /// True if the frame loaded can be interpolated
+  bool valid{false};
+  /// True if the last call to load_frame has loaded a new window
+  bool reloaded{false};
+};
+
+/// Loads the interpolation frame into memory, unless the point is in the
+/// cells of the frame already loaded: the frame is then kept as is.
+template <typename DataType>
+auto load_frame(const Grid2D<DataType>& grid, const double x, const double y,
+                const axis::Boundary boundary, const bool bounds_error,
+                detail::math::XArray2D& frame, FrameCell& cell) -> bool {
+  auto x_cell = grid.x()->find_indexes(x);
+  auto y_cell = grid.y()->find_indexes(y);
+  cell.reloaded = !(x_cell && y_cell && x_cell == cell.x && y_cell == cell.y);
+  if (cell.reloaded) {
+    cell.x = std::move(x_cell);
+    cell.y = std::move(y_cell);
+    cell.valid = load_frame(grid, x, y, boundary, bounds_error, frame);
+  }
+  return cell.valid;
+}
+
+/// Position of a coordinate in the cell of the axis framed by the nodes i0
+/// and i1: 0 on the node i0, 1 on the node i1.
+inline auto cell_position(const Axis<double>& axis, const double coordinate,
+                          const int64_t i0, const int64_t i1) -> double {
+  const auto x0 = axis(i0);
+  if (axis.is_angle()) {
+    return (detail::math::normalize_angle(coordinate, x0, 360.0) - x0) /
+           (detail::math::normalize_angle(axis(i1), x0, 360.0) - x0);
+  }
+  return (coordinate - x0) / (axis(i1) - x0);
+}
+
+/// Indexes of the four nodes of the axis surrounding a coordinate, or
+/// nothing if the coordinate cannot be framed. The boundary is only handled
+/// near the ends of the axis: elsewhere, no table is allocated.
+inline auto convolution_indexes(const Axis<double>& axis,
+                                const double coordinate,
+                                const axis::Boundary boundary)
+    -> std::optional<std::array<int64_t, 4>> {
+  const auto indexes = axis.find_indexes(coordinate);
+  if (indexes) {
+    auto [i0, i1] = *indexes;
+    if (i0 > 0 && i1 + 1 < axis.size()) {
+      return std::array<int64_t, 4>{i0 - 1, i0, i1, i1 + 1};
+    }
+  }
+  const auto window = axis.find_indexes(coordinate, 2, boundary);
+  if (window.empty()) {
+    return {};
+  }
+  return std::array<int64_t, 4>{window[0], window[1], window[2], window[3]};
+}
+
+/// Loads the values of the 4×4 nodes of the grid surrounding a point, q[ix *
+/// 4 + jx] holding the value of the node (x_ix, y_jx), and the position of
+/// the point in the cell framed by the nodes along X and Y. Returns nothing
+/// if the point cannot be framed.
+template <typename DataType>
+auto load_nodes(const Grid2D<DataType>& grid, const Axis<double>& x_axis,
+                const Axis<double>& y_axis, const double x, const double y,
+                const axis::Boundary boundary, const bool bounds_error)
+    -> std::optional<std::tuple<std::array<double, 16>, double, double>> {
+  const auto y_indexes = convolution_indexes(y_axis, y, boundary);
+  const auto x_indexes = convolution_indexes(x_axis, x, boundary);
+
+  if (!x_indexes || !y_indexes) {
+    if (bounds_error) {
+      if (!x_indexes) {
+        index_error("x", x, 2);
+      }
+      index_error("y", y, 2);
+    }
+    return {};
+  }
+
+  auto q = std::array<double, 16>();
+  for (size_t ix = 0; ix < 4; ++ix) {
+    for (size_t jx = 0; jx < 4; ++jx) {
+      q[ix * 4 + jx] = static_cast<double>(
+          grid.value((*x_indexes)[ix], (*y_indexes)[jx]));
+    }
+  }
+  return std::make_tuple(
+      q, cell_position(x_axis, x, (*x_indexes)[1], (*x_indexes)[2]),
+      cell_position(y_axis, y, (*y_indexes)[1], (*y_indexes)[2]));
+}
+
+/// Interpolates the value of a point with a fitting model evaluated in
+/// closed form on the 4×4 nodes of the grid surrounding it.
+template <typename DataType>
+auto closed_form_value(const Grid2D<DataType>& grid,
+                       const Axis<double>& x_axis, const Axis<double>& y_axis,
+                       const double x, const double y,
+                       const FittingModel fitting_model,
+                       const axis::Boundary boundary, const bool bounds_error)
+    -> double {
+  const auto nodes =
+      load_nodes(grid, x_axis, y_axis, x, y, boundary, bounds_error);
+  if (!nodes) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const auto& [q, t, u] = *nodes;
+  return detail::math::convolve(q, closed_form_weights(fitting_model, t),
+                                closed_form_weights(fitting_model, u));
+}
+
+/// Interpolates a layer of a frame of 4×4 nodes with the weights of a
+/// fitting model evaluated in closed form.
+inline auto closed_form_value(const detail::math::XArray2DView& layer,
+                              const std::array<double, 4>& wx,
+                              const std::array<double, 4>& wy) -> double {
+  auto q = std::array<double, 16>();
+  for (size_t ix = 0; ix < 4; ++ix) {
+    for (size_t jx = 0; jx < 4; ++jx) {
+      q[ix * 4 + jx] = layer.q(ix, jx);
+    }
+  }
+  return detail::math::convolve(q, wx, wy);
+}
+
+/// Weights of the 4×4 nodes of a frame surrounding the point (x, y), for a
+/// fitting model evaluated in closed form. The X-coordinate must be
+/// normalized with respect to the frame if the X axis is an angle.
+inline auto frame_weights(const detail::math::CoordsXY& frame, const double x,
+                          const double y, const FittingModel fitting_model)
+    -> std::pair<std::array<double, 4>, std::array<double, 4>> {
+  return {closed_form_weights(fitting_model,
+                              (x - frame.x(1)) / (frame.x(2) - frame.x(1))),
+          closed_form_weights(fitting_model,
+                              (y - frame.y(1)) / (frame.y(2) - frame.y(1)))};
+}
+
+/// Computes the coefficients of the bicubic polynomial interpolating the
+/// cell of the grid containing a point, from the values of the interpolated
+/// surface at the samples of the cell. Returns nothing if the point cannot
+/// be interpolated.
+template <typename DataType>
+auto cell_coefficients(const Grid2D<DataType>& grid,
+                       const Axis<double>& x_axis, const Axis<double>& y_axis,
+                       const double x, const double y,
+                       const FittingModel fitting_model,
+                       const axis::Boundary boundary, const bool bounds_error,
+                       detail::math::XArray2D& frame, FrameCell& cell,
+                       detail::math::Bicubic& interpolator)
+    -> std::optional<std::array<double, 16>> {
+  const auto& samples = detail::math::kBicubicSamples;
+  auto f = std::array<double, 16>();
+
+  if (is_closed_form(fitting_model)) {
+    const auto nodes =
+        load_nodes(grid, x_axis, y_axis, x, y, boundary, bounds_error);
+    if (!nodes) {
+      return {};
+    }
+    for (size_t ix = 0; ix < 4; ++ix) {
+      const auto wx = closed_form_weights(fitting_model, samples[ix]);
+      for (size_t jx = 0; jx < 4; ++jx) {
+        f[ix * 4 + jx] = detail::math::convolve(
+            std::get<0>(*nodes), wx,
+            closed_form_weights(fitting_model, samples[jx]));
+      }
+    }
+    return detail::math::bicubic_polynomial(f);
+  }
+
+  if (!load_frame(grid, x, y, boundary, bounds_error, frame, cell)) {
+    return {};
+  }
+  // The cell of the point is framed by the nodes nx - 1 and nx of the
+  // window along X, ny - 1 and ny along Y.
+  const auto x0 = frame.x(frame.nx() - 1);
+  const auto dx = frame.x(frame.nx()) - x0;
+  const auto y0 = frame.y(frame.ny() - 1);
+  const auto dy = frame.y(frame.ny()) - y0;
+  auto refit = cell.reloaded;
+  for (size_t ix = 0; ix < 4; ++ix) {
+    for (size_t jx = 0; jx < 4; ++jx) {
+      f[ix * 4 + jx] = interpolator.interpolate(
+          x0 + samples[ix] * dx, y0 + samples[jx] * dy, frame, refit);
+      refit = false;
+    }
+  }
+  return detail::math::bicubic_polynomial(f);
+}
+
+/// Computes the coefficients of the cubic B-spline interpolating the values
+/// of an array along its first two dimensions, for each index of its other
+/// dimensions.
+template <typename DataType>
+auto bspline_coefficients(const py::array_t<DataType>& array,
+                          const bool periodic, const size_t num_threads)
+    -> py::array_t<DataType> {
+  auto values =
+      py::array_t<DataType, py::array::c_style | py::array::forcecast>(array);
+  auto result = py::array_t<DataType>(py::array::ShapeContainer(
+      std::vector<ssize_t>(values.shape(), values.shape() + values.ndim())));
+  std::copy(values.data(), values.data() + values.size(),
+            result.mutable_data());
+
+  // The array is seen as a 3D array of shape (nx, ny, nr).
+  const auto nx = static_cast<size_t>(values.shape(0));
+  const auto ny = static_cast<size_t>(values.shape(1));
+  const auto nr = static_cast<size_t>(values.size()) / (nx * ny);
+  auto* data = result.mutable_data();
+  {
+    py::gil_scoped_release release;
+
+    // Captures the detected exceptions in the calculation function
+    // (only the last exception captured is kept)
+    auto except = std::exception_ptr(nullptr);
+
+    // Filters the lines of the array starting at "first", of "size" values
+    // separated by "stride" values.
+    auto filter = [&](const size_t count, const size_t size,
+                      const size_t stride, const bool periodic_line,
+                      const auto& first) {
+      detail::dispatch(
+          [&](const size_t start, const size_t end) {
+            try {
+              auto line = Eigen::VectorXd(size);
+              for (size_t ix = start; ix < end; ++ix) {
+                auto* item = data + first(ix);
+                for (size_t jx = 0; jx < size; ++jx) {
+                  line(jx) = static_cast<double>(item[jx * stride]);
+                }
+                detail::math::bspline_prefilter(line, periodic_line);
+                for (size_t jx = 0; jx < size; ++jx) {
+                  item[jx * stride] = static_cast<DataType>(line(jx));
+                }
+              }
+            } catch (...) {
+              except = std::current_exception();
+            }
+          },
+          count, num_threads);
+    };
+
+    // Along X, then along Y.
+    filter(ny * nr, nx, ny * nr, periodic,
+           [&](const size_t ix) { return ix; });
+    filter(nx * nr, ny, nr, false, [&](const size_t ix) {
+      return (ix / nr) * ny * nr + ix % nr;
+    });
+
+    if (except != nullptr) {
+      std::rethrow_exception(except);
+    }
+  }
+  return result;
+}
+
+/// Computes the coefficients of the cubic B-spline interpolating the grid
+template <typename DataType>
+auto spline_coefficients(const Grid2D<DataType>& grid,
+                         const size_t num_threads) -> Grid2D<DataType> {
+  check_closed_form(grid, kBSpline);
+  return Grid2D<DataType>(
+      grid.x(), grid.y(),
+      bspline_coefficients(grid.array(), grid.x()->is_circle(), num_threads));
+}
+
+/// Computes the coefficients of the cubic B-spline interpolating the grid
+template <typename DataType, typename AxisType>
+auto spline_coefficients(const Grid3D<DataType, AxisType>& grid,
+                         const size_t num_threads)
+    -> Grid3D<DataType, AxisType> {
+  check_closed_form(grid, kBSpline);
+  return Grid3D<DataType, AxisType>(
+      grid.x(), grid.y(), grid.z(),
+      bspline_coefficients(grid.array(), grid.x()->is_circle(), num_threads));
+}
+
+/// Computes the coefficients of the cubic B-spline interpolating the grid
+template <typename DataType, typename AxisType>
+auto spline_coefficients(const Grid4D<DataType, AxisType>& grid,
+                         const size_t num_threads)
+    -> Grid4D<DataType, AxisType> {
+  check_closed_form(grid, kBSpline);
+  return Grid4D<DataType, AxisType>(
+      grid.x(), grid.y(), grid.z(), grid.u(),
+      bspline_coefficients(grid.array(), grid.x()->is_circle(), num_threads));
+}
+
 /// Loads the interpolation frame into memory
 template <typename DataType, typename AxisType>
 auto load_frame(const Grid3D<DataType, AxisType>& grid, const double x,
@@ -214,22 +546,45 @@ auto load_frame(const Grid4D<DataType, AxisType>& grid, const double x,
   return frame.is_valid();
 }
 
-/// Evaluate the interpolation.
-template <typename DataType>
+/// Evaluate the interpolation. The calculations are done in double
+/// precision, whatever the type of the values returned.
+///
+/// @tparam Result type of the values returned
+template <typename DataType, typename Result = double>
 auto bicubic(const Grid2D<DataType>& grid, const py::array_t<double>& x,
              const py::array_t<double>& y, size_t nx, size_t ny,
              FittingModel fitting_model, const axis::Boundary boundary,
-             const bool bounds_error, size_t num_threads)
-    -> py::array_t<double> {
-  detail::check_array_ndim("x", 1, x, "y", 1, y);
+             const bool bounds_error, size_t num_threads,
+             const bool spatial_sort, const Output& out, BicubicCache* cache)
+    -> py::array_t<Result> {
   detail::check_ndarray_shape("x", x, "y", y);
+  check_closed_form(grid, fitting_model);
+  const auto closed_form = is_closed_form(fitting_model);
+  if (cache != nullptr && !is_bicubic_polynomial(fitting_model)) {
+    throw std::invalid_argument(
+        "The cache is only available for the fitting models interpolating a "
+        "bicubic polynomial in each cell: linear, cubic splines, cubic "
+        "convolution and B-spline");
+  }
+
+  // The points are interpolated in the order of their position on the grid,
+  // then the results are put back in the order of the points provided.
+  if (spatial_sort) {
+    auto order = spatial_order(*grid.x(), x, *grid.y(), y, num_threads);
+    return scatter(bicubic<DataType, Result>(
+                       grid, gather(x, order, num_threads),
+                       gather(y, order, num_threads), nx, ny, fitting_model,
+                       boundary, bounds_error, num_threads, false,
+                       std::nullopt, cache),
+                   order, shape_of(x), num_threads, out);
+  }
 
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = output_array<Result>(out, shape_of(x));
 
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _result = result.template mutable_unchecked<1>();
+  auto _x = FlatView<double>(x);
+  auto _y = FlatView<double>(y);
+  auto* _result = result.mutable_data();
   {
     py::gil_scoped_release release;
 
@@ -239,24 +594,99 @@ auto bicubic(const Grid2D<DataType>& grid, const py::array_t<double>& x,
 
     // Access to the shared pointer outside the loop to avoid data races
     const auto is_angle = grid.x()->is_angle();
+    const auto& x_axis = *grid.x();
+    const auto& y_axis = *grid.y();
 
     detail::dispatch(
         [&](const size_t start, const size_t end) {
           try {
+            // The coefficients of the cells are searched in the cache, then
+            // kept while the points stay in the same cell.
+            if (cache != nullptr) {
+              auto frame = detail::math::XArray2D(nx, ny);
+              auto interpolator = detail::math::Bicubic(
+                  frame, interp_type(closed_form ? kCSpline : fitting_model));
+              auto cell = FrameCell();
+              // The closed forms do not depend on the size of the window.
+              auto key = BicubicCell{
+                  grid.id(), -1, -1,
+                  static_cast<uint32_t>(closed_form ? 2 : nx),
+                  static_cast<uint32_t>(closed_form ? 2 : ny), fitting_model,
+                  boundary};
+              auto undefined = std::array<double, 16>();
+              undefined.fill(std::numeric_limits<double>::quiet_NaN());
+              auto coefficients = undefined;
+
+              for (size_t ix = start; ix < end; ++ix) {
+                auto xi = _x(ix);
+                auto yi = _y(ix);
+                const auto x_cell = x_axis.find_indexes(xi);
+                const auto y_cell = y_axis.find_indexes(yi);
+                if (!x_cell || !y_cell) {
+                  if (bounds_error) {
+                    if (!x_cell) {
+                      index_error("x", xi, key.nx);
+                    }
+                    index_error("y", yi, key.ny);
+                  }
+                  _result[ix] = std::numeric_limits<double>::quiet_NaN();
+                  continue;
+                }
+                const auto [i0, i1] = *x_cell;
+                const auto [j0, j1] = *y_cell;
+                if (key.ix != i0 || key.iy != j0) {
+                  key.ix = i0;
+                  key.iy = j0;
+                  auto found = cache->find(key);
+                  if (!found) {
+                    found = cell_coefficients(grid, x_axis, y_axis, xi, yi,
+                                              fitting_model, boundary,
+                                              bounds_error, frame, cell,
+                                              interpolator);
+                    // The cells that cannot be interpolated are not cached,
+                    // their values depend on bounds_error.
+                    if (found) {
+                      cache->insert(key, *found);
+                    }
+                  }
+                  coefficients = found.value_or(undefined);
+                }
+                _result[ix] = detail::math::evaluate_bicubic_polynomial(
+                    coefficients, cell_position(x_axis, xi, i0, i1),
+                    cell_position(y_axis, yi, j0, j1));
+              }
+              return;
+            }
+
+            // The fitting models evaluated in closed form sum the values of
+            // the nodes: no spline to fit.
+            if (closed_form) {
+              for (size_t ix = start; ix < end; ++ix) {
+                _result[ix] = closed_form_value(grid, x_axis, y_axis, _x(ix),
+                                                _y(ix), fitting_model,
+                                                boundary, bounds_error);
+              }
+              return;
+            }
+
             auto frame = detail::math::XArray2D(nx, ny);
             auto interpolator =
                 detail::math::Bicubic(frame, interp_type(fitting_model));
 
+            // Consecutive points in the same cell, as along a track, share
+            // the frame and the splines fitted on its rows.
+            auto cell = FrameCell();
+
             for (size_t ix = start; ix < end; ++ix) {
               auto xi = _x(ix);
               auto yi = _y(ix);
-              _result(ix) =
+              _result[ix] =
                   // The grid instance is accessed as a constant reference, no
                   // data race problem here.
-                  load_frame(grid, xi, yi, boundary, bounds_error, frame)
+                  load_frame(grid, xi, yi, boundary, bounds_error, frame, cell)
                       ? interpolator.interpolate(
                             is_angle ? frame.normalize_angle(xi) : xi, yi,
-                            frame)
+                            frame, cell.reloaded)
                       : std::numeric_limits<double>::quiet_NaN();
             }
           } catch (...) {
@@ -272,24 +702,124 @@ auto bicubic(const Grid2D<DataType>& grid, const py::array_t<double>& x,
   return result;
 }
 
-/// Evaluate the interpolation.
-template <typename DataType, typename AxisType>
+/// Evaluate the interpolation and the partial derivatives of the
+/// interpolated surface.
+template <typename DataType>
+auto bicubic_gradient(const Grid2D<DataType>& grid,
+                      const py::array_t<double>& x,
+                      const py::array_t<double>& y, size_t nx, size_t ny,
+                      FittingModel fitting_model,
+                      const axis::Boundary boundary, const bool mixed,
+                      const bool bounds_error, size_t num_threads)
+    -> py::tuple {
+  detail::check_ndarray_shape("x", x, "y", y);
+  if (is_closed_form(fitting_model)) {
+    throw std::invalid_argument(
+        "The gradient is not available for the cubic convolution and the "
+        "B-spline");
+  }
+
+  auto size = x.size();
+  auto count = mixed ? 4 : 3;
+  auto results = std::array<py::array_t<double>, 4>();
+  auto pointers = std::array<double*, 4>();
+  for (auto ix = 0; ix < count; ++ix) {
+    results[ix] = py::array_t<double>(py::array::ShapeContainer(shape_of(x)));
+    pointers[ix] = results[ix].mutable_data();
+  }
+
+  auto _x = FlatView<double>(x);
+  auto _y = FlatView<double>(y);
+  {
+    py::gil_scoped_release release;
+
+    // Captures the detected exceptions in the calculation function
+    // (only the last exception captured is kept)
+    auto except = std::exception_ptr(nullptr);
+
+    // Access to the shared pointer outside the loop to avoid data races
+    const auto is_angle = grid.x()->is_angle();
+
+    detail::dispatch(
+        [&](const size_t start, const size_t end) {
+          try {
+            auto frame = detail::math::XArray2D(nx, ny);
+            auto interpolator =
+                detail::math::Bicubic(frame, interp_type(fitting_model));
+            auto cell = FrameCell();
+
+            for (size_t ix = start; ix < end; ++ix) {
+              auto xi = _x(ix);
+              auto yi = _y(ix);
+              if (load_frame(grid, xi, yi, boundary, bounds_error, frame,
+                             cell)) {
+                auto gradient = interpolator.gradient(
+                    is_angle ? frame.normalize_angle(xi) : xi, yi, frame);
+                for (auto jx = 0; jx < count; ++jx) {
+                  pointers[jx][ix] = gradient[jx];
+                }
+              } else {
+                for (auto jx = 0; jx < count; ++jx) {
+                  pointers[jx][ix] = std::numeric_limits<double>::quiet_NaN();
+                }
+              }
+            }
+          } catch (...) {
+            except = std::current_exception();
+          }
+        },
+        size, num_threads);
+
+    if (except != nullptr) {
+      std::rethrow_exception(except);
+    }
+  }
+  return mixed ? py::make_tuple(results[0], results[1], results[2],
+                                results[3])
+               : py::make_tuple(results[0], results[1], results[2]);
+}
+
+/// Evaluate the interpolation. The calculations are done in double
+/// precision, whatever the type of the values returned.
+///
+/// @tparam Result type of the values returned
+template <typename DataType, typename AxisType, typename Result = double>
 auto bicubic_3d(const Grid3D<DataType, AxisType>& grid,
                 const py::array_t<double>& x, const py::array_t<double>& y,
                 const py::array_t<AxisType>& z, size_t nx, size_t ny,
                 FittingModel fitting_model, const axis::Boundary boundary,
-                const bool bounds_error, size_t num_threads)
-    -> py::array_t<double> {
-  detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z);
+                const bool bounds_error, size_t num_threads,
+                const bool spatial_sort, const Output& out, size_t nz)
+    -> py::array_t<Result> {
   detail::check_ndarray_shape("x", x, "y", y, "z", z);
+  check_closed_form(grid, fitting_model);
+
+  // The points are interpolated in the order of their position on the grid,
+  // then the results are put back in the order of the points provided.
+  if (spatial_sort) {
+    auto order = spatial_order(*grid.x(), x, *grid.y(), y, *grid.z(), z,
+                               num_threads);
+    return scatter(bicubic_3d<DataType, AxisType, Result>(
+                       grid, gather(x, order, num_threads),
+                       gather(y, order, num_threads),
+                       gather(z, order, num_threads), nx, ny, fitting_model,
+                       boundary, bounds_error, num_threads, false,
+                       std::nullopt, nz),
+                   order, shape_of(x), num_threads, out);
+  }
 
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = output_array<Result>(out, shape_of(x));
+
+  auto _x = FlatView<double>(x);
+  auto _y = FlatView<double>(y);
+  auto _z = FlatView<AxisType>(z);
+  auto* _result = result.mutable_data();
+  // Snapshot of the grid: the values replaced by "update_array" or
+  // "update_slice" while the GIL is released are not seen by this
+  // calculation.
+  const auto snapshot = grid;
 
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
-  auto _result = result.template mutable_unchecked<1>();
   {
     py::gil_scoped_release release;
 
@@ -298,29 +828,47 @@ auto bicubic_3d(const Grid3D<DataType, AxisType>& grid,
     auto except = std::exception_ptr(nullptr);
 
     // Access to the shared pointer outside the loop to avoid data races
-    const auto is_angle = grid.x()->is_angle();
+    const auto is_angle = snapshot.x()->is_angle();
+
+    // The fitting models evaluated in closed form use a frame of 4×4 nodes
+    // in the XY plane, and natural cubic splines along the other axes.
+    const auto closed_form = is_closed_form(fitting_model);
+    const auto spline_model = closed_form ? kCSpline : fitting_model;
 
     detail::dispatch(
         [&](const size_t start, const size_t end) {
           try {
-            auto frame = detail::math::XArray3D<AxisType>(nx, ny, 1);
+            auto frame = closed_form
+                             ? detail::math::XArray3D<AxisType>(2, 2, nz)
+                             : detail::math::XArray3D<AxisType>(nx, ny, nz);
             auto interpolator = detail::math::Bicubic(
-                detail::math::XArray2D(nx, ny), interp_type(fitting_model));
+                detail::math::XArray2D(nx, ny), interp_type(spline_model));
+            auto z_interpolator = detail::math::LayerInterpolator<AxisType>(
+                nz, interp_type(spline_model));
+            auto& z_values = z_interpolator.values();
 
             for (size_t ix = start; ix < end; ++ix) {
               auto xi = _x(ix);
               auto yi = _y(ix);
               auto zi = _z(ix);
 
-              if (load_frame<DataType, AxisType>(grid, xi, yi, zi, boundary,
+              if (load_frame<DataType, AxisType>(snapshot, xi, yi, zi, boundary,
                                                  bounds_error, frame)) {
                 xi = is_angle ? frame.normalize_angle(xi) : xi;
-                auto z0 = interpolator.interpolate(xi, yi, frame.xarray_2d(0));
-                auto z1 = interpolator.interpolate(xi, yi, frame.xarray_2d(1));
-                _result(ix) = detail::math::linear<AxisType, double>(
-                    zi, frame.z(0), frame.z(1), z0, z1);
+                const auto [wx, wy] =
+                    closed_form ? frame_weights(frame, xi, yi, fitting_model)
+                                : std::pair<std::array<double, 4>,
+                                            std::array<double, 4>>();
+                for (Eigen::Index kx = 0; kx < z_values.size(); ++kx) {
+                  z_values(kx) =
+                      closed_form
+                          ? closed_form_value(frame.xarray_2d(kx), wx, wy)
+                          : interpolator.interpolate(xi, yi,
+                                                     frame.xarray_2d(kx));
+                }
+                _result[ix] = z_interpolator.interpolate(frame.z(), zi);
               } else {
-                _result(ix) = std::numeric_limits<double>::quiet_NaN();
+                _result[ix] = std::numeric_limits<double>::quiet_NaN();
               }
             }
           } catch (...) {
@@ -336,25 +884,51 @@ auto bicubic_3d(const Grid3D<DataType, AxisType>& grid,
   return result;
 }
 
-/// Evaluate the interpolation.
-template <typename DataType, typename AxisType>
+/// Evaluate the interpolation. The calculations are done in double
+/// precision, whatever the type of the values returned.
+///
+/// @tparam Result type of the values returned
+template <typename DataType, typename AxisType, typename Result = double>
 auto bicubic_4d(const Grid4D<DataType, AxisType>& grid,
                 const py::array_t<double>& x, const py::array_t<double>& y,
                 const py::array_t<AxisType>& z, const py::array_t<double>& u,
                 size_t nx, size_t ny, FittingModel fitting_model,
                 const axis::Boundary boundary, const bool bounds_error,
-                size_t num_threads) -> py::array_t<double> {
-  detail::check_array_ndim("x", 1, x, "y", 1, y, "z", 1, z, "u", 1, u);
+                size_t num_threads, const bool spatial_sort,
+                const Output& out, size_t nz, size_t nu)
+    -> py::array_t<Result> {
   detail::check_ndarray_shape("x", x, "y", y, "z", z, "u", u);
+  check_closed_form(grid, fitting_model);
+
+  // The points are interpolated in the order of their position on the grid,
+  // then the results are put back in the order of the points provided. The
+  // last dimension, interpolated linearly, is not used to sort the points.
+  if (spatial_sort) {
+    auto order = spatial_order(*grid.x(), x, *grid.y(), y, *grid.z(), z,
+                               num_threads);
+    return scatter(bicubic_4d<DataType, AxisType, Result>(
+                       grid, gather(x, order, num_threads),
+                       gather(y, order, num_threads),
+                       gather(z, order, num_threads),
+                       gather(u, order, num_threads), nx, ny, fitting_model,
+                       boundary, bounds_error, num_threads, false,
+                       std::nullopt, nz, nu),
+                   order, shape_of(x), num_threads, out);
+  }
 
   auto size = x.size();
-  auto result = py::array_t<double>(py::array::ShapeContainer{size});
+  auto result = output_array<Result>(out, shape_of(x));
+
+  auto _x = FlatView<double>(x);
+  auto _y = FlatView<double>(y);
+  auto _z = FlatView<AxisType>(z);
+  auto _u = FlatView<double>(u);
+  auto* _result = result.mutable_data();
+  // Snapshot of the grid: the values replaced by "update_array" or
+  // "update_slice" while the GIL is released are not seen by this
+  // calculation.
+  const auto snapshot = grid;
 
-  auto _x = x.template unchecked<1>();
-  auto _y = y.template unchecked<1>();
-  auto _z = z.template unchecked<1>();
-  auto _u = u.template unchecked<1>();
-  auto _result = result.template mutable_unchecked<1>();
   {
     py::gil_scoped_release release;
 
@@ -363,14 +937,28 @@ auto bicubic_4d(const Grid4D<DataType, AxisType>& grid,
     auto except = std::exception_ptr(nullptr);
 
     // Access to the shared pointer outside the loop to avoid data races
-    const auto is_angle = grid.x()->is_angle();
+    const auto is_angle = snapshot.x()->is_angle();
+
+    // The fitting models evaluated in closed form use a frame of 4×4 nodes
+    // in the XY plane, and natural cubic splines along the other axes.
+    const auto closed_form = is_closed_form(fitting_model);
+    const auto spline_model = closed_form ? kCSpline : fitting_model;
 
     detail::dispatch(
         [&](const size_t start, const size_t end) {
           try {
-            auto frame = detail::math::XArray4D<AxisType>(nx, ny, 1, 1);
+            auto frame =
+                closed_form
+                    ? detail::math::XArray4D<AxisType>(2, 2, nz, nu)
+                    : detail::math::XArray4D<AxisType>(nx, ny, nz, nu);
             auto interpolator = detail::math::Bicubic(
-                detail::math::XArray2D(nx, ny), interp_type(fitting_model));
+                detail::math::XArray2D(nx, ny), interp_type(spline_model));
+            auto z_interpolator = detail::math::LayerInterpolator<AxisType>(
+                nz, interp_type(spline_model));
+            auto u_interpolator = detail::math::LayerInterpolator<double>(
+                nu, interp_type(spline_model));
+            auto& z_values = z_interpolator.values();
+            auto& u_values = u_interpolator.values();
 
             for (size_t ix = start; ix < end; ++ix) {
               auto xi = _x(ix);
@@ -378,25 +966,30 @@ auto bicubic_4d(const Grid4D<DataType, AxisType>& grid,
               auto zi = _z(ix);
               auto ui = _u(ix);
 
-              if (load_frame<DataType, AxisType>(grid, xi, yi, zi, ui, boundary,
-                                                 bounds_error, frame)) {
+              if (load_frame<DataType, AxisType>(snapshot, xi, yi, zi, ui,
+                                                 boundary, bounds_error,
+                                                 frame)) {
                 xi = is_angle ? frame.normalize_angle(xi) : xi;
-                auto z00 =
-                    interpolator.interpolate(xi, yi, frame.xarray_2d(0, 0));
-                auto z10 =
-                    interpolator.interpolate(xi, yi, frame.xarray_2d(1, 0));
-                auto z01 =
-                    interpolator.interpolate(xi, yi, frame.xarray_2d(0, 1));
-                auto z11 =
-                    interpolator.interpolate(xi, yi, frame.xarray_2d(1, 1));
-                _result(ix) = detail::math::linear<double>(
-                    ui, frame.u(0), frame.u(1),
-                    detail::math::linear<AxisType, double>(
-                        zi, frame.z(0), frame.z(1), z00, z10),
-                    detail::math::linear<AxisType, double>(
-                        zi, frame.z(0), frame.z(1), z01, z11));
+                const auto [wx, wy] =
+                    closed_form ? frame_weights(frame, xi, yi, fitting_model)
+                                : std::pair<std::array<double, 4>,
+                                            std::array<double, 4>>();
+                // The layers are interpolated along Z, then the values
+                // obtained along U.
+                for (Eigen::Index lx = 0; lx < u_values.size(); ++lx) {
+                  for (Eigen::Index kx = 0; kx < z_values.size(); ++kx) {
+                    z_values(kx) =
+                        closed_form
+                            ? closed_form_value(frame.xarray_2d(kx, lx), wx,
+                                                wy)
+                            : interpolator.interpolate(
+                                  xi, yi, frame.xarray_2d(kx, lx));
+                  }
+                  u_values(lx) = z_interpolator.interpolate(frame.z(), zi);
+                }
+                _result[ix] = u_interpolator.interpolate(frame.u(), ui);
               } else {
-                _result(ix) = std::numeric_limits<double>::quiet_NaN();
+                _result[ix] = std::numeric_limits<double>::quiet_NaN();
               }
             }
           } catch (...) {
@@ -425,12 +1018,90 @@ void implement_bicubic(py::module& m, const std::string& suffix) {
         py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
         py::arg("boundary") = pyinterp::axis::kUndef,
         py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+        py::arg("spatial_sort") = false, py::arg("out") = py::none(),
+        py::arg("cache") = py::none(),
         (R"__doc__(
 Extension of cubic interpolation for interpolating data points on a
 two-dimensional regular grid. The interpolated surface is smoother than
 corresponding surfaces obtained by bilinear interpolation or
 nearest-neighbor interpolation.
 
+Args:
+    grid (pyinterp.core.Grid2D)__doc__" +
+         suffix +
+         R"__doc__(): Grid containing the values to be interpolated.
+    x (numpy.ndarray): X-values
+    y (numpy.ndarray): Y-values
+    nx (int, optional): The number of X coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    ny (int, optional): The number of Y coordinate values required to perform
+        the interpolation. Defaults to ``3``.
+    fitting_model (pyinterp.core.FittingModel, optional): Type of interpolation
+        to be performed. Defaults to
+        :py:data:`pyinterp.core.FittingModel.CSpline`. With
+        :py:data:`pyinterp.core.FittingModel.BSpline`, the grid must hold the
+        coefficients computed by ``spline_coefficients``: the values of a
+        grid passed as is are smoothed, not interpolated.
+    boundary (pyinterp.core.AxisBoundary, optional): Type of axis boundary
+        management. Defaults to
+        :py:data:`pyinterp.core.AxisBoundary.Undef`
+    bounds_error (bool, optional): If True, when interpolated values are
+        requested outside of the domain of the input axes (x,y), a ValueError
+        is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    spatial_sort (bool, optional): If True, the points are interpolated in
+        the order of their position on the grid, which limits the cache
+        misses when the points are provided in a random order, and the
+        results are returned in the order of the points provided. Sorting
+        the points pays off from about 100,000 points. Defaults to
+        ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result. It must not overlap the coordinates.
+    cache (pyinterp.core.BicubicCache, optional): Cache of the coefficients
+        of the cells interpolated, shared between the calls. Available for
+        the fitting models interpolating a bicubic polynomial in each cell:
+        ``Linear``, ``CSpline``, ``CSplinePeriodic``, ``CubicConvolution``
+        and ``BSpline``.
+Return:
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates.
+  )__doc__")
+            .c_str());
+
+  if constexpr (std::is_same_v<DataType, float>) {
+    m.def(("bicubic_narrow_" + function_suffix).c_str(),
+          &pyinterp::bicubic<DataType, float>, py::arg("grid"), py::arg("x"),
+          py::arg("y"), py::arg("nx") = 3, py::arg("ny") = 3,
+          py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
+          py::arg("boundary") = pyinterp::axis::kUndef,
+          py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+          py::arg("spatial_sort") = false, py::arg("out") = py::none(),
+          py::arg("cache") = py::none(),
+          R"__doc__(
+Bicubic interpolation of a grid of float32 values, returning the values
+interpolated as float32, which halves the memory used by the results. Only
+the output is float32: the values are calculated in double precision, as by
+:py:func:`pyinterp.core.bicubic_float32`, whose arguments are the same.
+)__doc__");
+  }
+
+  m.def(("bicubic_gradient_" + function_suffix).c_str(),
+        &pyinterp::bicubic_gradient<DataType>, py::arg("grid"), py::arg("x"),
+        py::arg("y"), py::arg("nx") = 3, py::arg("ny") = 3,
+        py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
+        py::arg("boundary") = pyinterp::axis::kUndef,
+        py::arg("mixed") = false, py::arg("bounds_error") = false,
+        py::arg("num_threads") = 0,
+        (R"__doc__(
+Bicubic interpolation of the values provided on the defined bivariate
+function, and calculation of the partial derivatives of the interpolated
+surface. The interpolation frame is loaded and the splines are fitted only
+once per point for the value and its derivatives.
+
 Args:
     grid (pyinterp.core.Grid2D)__doc__" +
          suffix +
@@ -447,6 +1118,8 @@ Args:
     boundary (pyinterp.core.AxisBoundary, optional): Type of axis boundary
         management. Defaults to
         :py:data:`pyinterp.core.AxisBoundary.Undef`
+    mixed (bool, optional): If True, the mixed derivative d²f/dxdy is also
+        calculated. Defaults to ``False``.
     bounds_error (bool, optional): If True, when interpolated values are
         requested outside of the domain of the input axes (x,y), a ValueError
         is raised. If False, then value is set to NaN.
@@ -455,7 +1128,40 @@ Args:
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
 Return:
-    numpy.ndarray: Values interpolated
+    tuple: The values interpolated, df/dx, df/dy, and d²f/dxdy if
+    requested, arrays of the shape of the coordinates. The derivatives are
+    expressed per unit of the axes.
+  )__doc__")
+            .c_str());
+
+  m.def(("spline_coefficients_" + function_suffix).c_str(),
+        &pyinterp::spline_coefficients<DataType>, py::arg("grid"),
+        py::arg("num_threads") = 0,
+        (R"__doc__(
+Computes the coefficients of the cubic B-spline interpolating the grid along
+its X and Y axes, to interpolate the grid with the fitting model
+:py:data:`pyinterp.core.FittingModel.BSpline`. The coefficients are computed
+once for all the interpolations of the grid.
+
+Along a circle X axis, the values are periodic. Elsewhere, they are extended
+by mirror symmetry: to interpolate the points located in the first or last
+cell of the axis, use the boundary :py:data:`pyinterp.core.AxisBoundary.Sym`,
+otherwise these points are not defined. The undefined values split the lines
+into independent segments.
+
+Args:
+    grid (pyinterp.core.Grid2D)__doc__" +
+         suffix +
+         R"__doc__(): Grid containing the values to be interpolated. Its X
+        and Y axes must be regular.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    pyinterp.core.Grid2D)__doc__" +
+         suffix +
+         R"__doc__(: The coefficients, defined on the axes of the grid.
   )__doc__")
             .c_str());
 }
@@ -472,11 +1178,14 @@ void implement_bicubic_3d(py::module& m, const std::string& prefix,
         py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
         py::arg("boundary") = pyinterp::axis::kUndef,
         py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+        py::arg("spatial_sort") = false, py::arg("out") = py::none(),
+        py::arg("nz") = 1,
         (R"__doc__(
 Extension of cubic interpolation for interpolating data points on a
 three-dimensional regular grid. A bicubic interpolation is performed along the
 X and Y axes of the 3D grid, and linearly along the Z axis between the two
-values obtained by the spatial bicubic interpolation.
+values obtained by the spatial bicubic interpolation, or with a spline if
+``nz`` is greater than one.
 
 Args:
     grid (pyinterp.core.)__doc__" +
@@ -491,7 +1200,10 @@ Args:
         the interpolation. Defaults to ``3``.
     fitting_model (pyinterp.core.FittingModel, optional): Type of interpolation
         to be performed. Defaults to
-        :py:data:`pyinterp.core.FittingModel.CSpline`
+        :py:data:`pyinterp.core.FittingModel.CSpline`. With
+        :py:data:`pyinterp.core.FittingModel.BSpline`, the grid must hold the
+        coefficients computed by ``spline_coefficients``: the values of a
+        grid passed as is are smoothed, not interpolated.
     boundary (pyinterp.core.AxisBoundary, optional): Type of axis boundary
         management. Defaults to
         :py:data:`pyinterp.core.AxisBoundary.Undef`
@@ -502,8 +1214,72 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    spatial_sort (bool, optional): If True, the points are interpolated in
+        the order of their position on the grid, which limits the cache
+        misses when the points are provided in a random order, and the
+        results are returned in the order of the points provided. Sorting
+        the points pays off from about 100,000 points. Defaults to
+        ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result. It must not overlap the coordinates.
+    nz (int, optional): Half the number of Z coordinate values used to
+        perform the interpolation along the Z axis. With ``1``, the values
+        are interpolated linearly between the two layers framing the point,
+        otherwise a spline of the fitting model is fitted on the ``2 * nz``
+        layers surrounding it. Defaults to ``1``.
+Return:
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates.
+  )__doc__")
+            .c_str());
+
+  if constexpr (std::is_same_v<DataType, float>) {
+    m.def(("bicubic_narrow_" + function_suffix).c_str(),
+          &pyinterp::bicubic_3d<DataType, AxisType, float>, py::arg("grid"),
+          py::arg("x"), py::arg("y"), py::arg("z"), py::arg("nx") = 3,
+          py::arg("ny") = 3,
+          py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
+          py::arg("boundary") = pyinterp::axis::kUndef,
+          py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+          py::arg("spatial_sort") = false, py::arg("out") = py::none(),
+          py::arg("nz") = 1,
+          R"__doc__(
+Bicubic interpolation of a 3D grid of float32 values, returning the values
+interpolated as float32. Only the output is float32: the values are
+calculated in double precision, as by :py:func:`pyinterp.core.bicubic_float32`,
+whose arguments are the same.
+)__doc__");
+  }
+
+  m.def(("spline_coefficients_" + function_suffix).c_str(),
+        &pyinterp::spline_coefficients<DataType, AxisType>, py::arg("grid"),
+        py::arg("num_threads") = 0,
+        (R"__doc__(
+Computes the coefficients of the cubic B-spline interpolating the grid along
+its X and Y axes, to interpolate the grid with the fitting model
+:py:data:`pyinterp.core.FittingModel.BSpline`. The coefficients are computed
+once for all the interpolations of the grid.
+
+Along a circle X axis, the values are periodic. Elsewhere, they are extended
+by mirror symmetry: to interpolate the points located in the first or last
+cell of the axis, use the boundary :py:data:`pyinterp.core.AxisBoundary.Sym`,
+otherwise these points are not defined. The undefined values split the lines
+into independent segments.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+         prefix + "Grid3D" + suffix +
+         R"__doc__(): Grid containing the values to be interpolated. Its X
+        and Y axes must be regular.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
 Return:
-    numpy.ndarray: Values interpolated
+    pyinterp.core.)__doc__" +
+         prefix + "Grid3D" + suffix +
+         R"__doc__(: The coefficients, defined on the axes of the grid.
   )__doc__")
             .c_str());
 }
@@ -520,11 +1296,14 @@ void implement_bicubic_4d(py::module& m, const std::string& prefix,
         py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
         py::arg("boundary") = pyinterp::axis::kUndef,
         py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+        py::arg("spatial_sort") = false, py::arg("out") = py::none(),
+        py::arg("nz") = 1, py::arg("nu") = 1,
         (R"__doc__(
 Extension of cubic interpolation for interpolating data points on a
 three-dimensional regular grid. A bicubic interpolation is performed along the
 X and Y axes of the 4D grid, and linearly along the Z and U axes between the
-four values obtained by the spatial bicubic interpolation.
+four values obtained by the spatial bicubic interpolation, or with a spline
+along the axes for which ``nz`` or ``nu`` is greater than one.
 
 Args:
     grid (pyinterp.core.)__doc__" +
@@ -540,7 +1319,10 @@ Args:
         the interpolation. Defaults to ``3``.
     fitting_model (pyinterp.core.FittingModel, optional): Type of interpolation
         to be performed. Defaults to
-        :py:data:`pyinterp.core.FittingModel.CSpline`
+        :py:data:`pyinterp.core.FittingModel.CSpline`. With
+        :py:data:`pyinterp.core.FittingModel.BSpline`, the grid must hold the
+        coefficients computed by ``spline_coefficients``: the values of a
+        grid passed as is are smoothed, not interpolated.
     boundary (pyinterp.core.AxisBoundary, optional): Type of axis boundary
         management. Defaults to
         :py:data:`pyinterp.core.AxisBoundary.Undef`
@@ -551,8 +1333,75 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    spatial_sort (bool, optional): If True, the points are interpolated in
+        the order of their position on the grid, which limits the cache
+        misses when the points are provided in a random order, and the
+        results are returned in the order of the points provided. Sorting
+        the points pays off from about 100,000 points. Defaults to
+        ``False``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result. It must not overlap the coordinates.
+    nz (int, optional): Half the number of Z coordinate values used to
+        perform the interpolation along the Z axis. With ``1``, the values
+        are interpolated linearly between the two layers framing the point,
+        otherwise a spline of the fitting model is fitted on the ``2 * nz``
+        layers surrounding it. Defaults to ``1``.
+    nu (int, optional): Half the number of U coordinate values used to
+        perform the interpolation along the U axis, as ``nz`` for the Z axis.
+        Defaults to ``1``.
 Return:
-    numpy.ndarray: Values interpolated
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates.
+  )__doc__")
+            .c_str());
+
+  if constexpr (std::is_same_v<DataType, float>) {
+    m.def(("bicubic_narrow_" + function_suffix).c_str(),
+          &pyinterp::bicubic_4d<DataType, AxisType, float>, py::arg("grid"),
+          py::arg("x"), py::arg("y"), py::arg("z"), py::arg("u"),
+          py::arg("nx") = 3, py::arg("ny") = 3,
+          py::arg("fitting_model") = pyinterp::FittingModel::kCSpline,
+          py::arg("boundary") = pyinterp::axis::kUndef,
+          py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+          py::arg("spatial_sort") = false, py::arg("out") = py::none(),
+          py::arg("nz") = 1, py::arg("nu") = 1,
+          R"__doc__(
+Bicubic interpolation of a 4D grid of float32 values, returning the values
+interpolated as float32. Only the output is float32: the values are
+calculated in double precision, as by :py:func:`pyinterp.core.bicubic_float32`,
+whose arguments are the same.
+)__doc__");
+  }
+
+  m.def(("spline_coefficients_" + function_suffix).c_str(),
+        &pyinterp::spline_coefficients<DataType, AxisType>, py::arg("grid"),
+        py::arg("num_threads") = 0,
+        (R"__doc__(
+Computes the coefficients of the cubic B-spline interpolating the grid along
+its X and Y axes, to interpolate the grid with the fitting model
+:py:data:`pyinterp.core.FittingModel.BSpline`. The coefficients are computed
+once for all the interpolations of the grid.
+
+Along a circle X axis, the values are periodic. Elsewhere, they are extended
+by mirror symmetry: to interpolate the points located in the first or last
+cell of the axis, use the boundary :py:data:`pyinterp.core.AxisBoundary.Sym`,
+otherwise these points are not defined. The undefined values split the lines
+into independent segments.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+         prefix + "Grid4D" + suffix +
+         R"__doc__(): Grid containing the values to be interpolated. Its X
+        and Y axes must be regular.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+Return:
+    pyinterp.core.)__doc__" +
+         prefix + "Grid4D" + suffix +
+         R"__doc__(: The coefficients, defined on the axes of the grid.
   )__doc__")
             .c_str());
 }
@@ -576,7 +1425,40 @@ Bicubic fitting model
       .value(
           "Steffen", pyinterp::FittingModel::kSteffen,
           "*Steffen’s method guarantees the monotonicity of data points. the "
-          "interpolating function between the given*.");
+          "interpolating function between the given*.")
+      .value("CubicConvolution", pyinterp::FittingModel::kCubicConvolution,
+             "*Cubic convolution of Keys (Catmull-Rom spline), computed in "
+             "closed form on the 4x4 nodes surrounding the point; available "
+             "only for grids with regular X and Y axes*.")
+      .value("BSpline", pyinterp::FittingModel::kBSpline,
+             "*Cubic B-spline, evaluated in closed form on the coefficients "
+             "computed by spline_coefficients; available only for grids "
+             "with regular X and Y axes*.");
+
+  py::class_<pyinterp::BicubicCache>(m, "BicubicCache", R"__doc__(
+Cache of the coefficients of the bicubic polynomials interpolating the most
+recently used cells of 2D grids, shared between the calls to the bicubic
+interpolation and between threads.
+
+A cell is identified by the values of the grid, its indexes, the size of the
+interpolation window, the fitting model and the boundary handling. The
+values of the grids cached must not be modified in place.
+)__doc__")
+      .def(py::init<size_t>(), py::arg("capacity"), R"__doc__(
+Default constructor
+
+Args:
+    capacity (int): Maximum number of cells kept.
+)__doc__")
+      .def_property_readonly("capacity", &pyinterp::BicubicCache::capacity,
+                             "Maximum number of cells kept")
+      .def_property_readonly("hits", &pyinterp::BicubicCache::hits,
+                             "Number of cells found in the cache")
+      .def_property_readonly("misses", &pyinterp::BicubicCache::misses,
+                             "Number of cells not found in the cache")
+      .def("__len__", &pyinterp::BicubicCache::size)
+      .def("clear", &pyinterp::BicubicCache::clear,
+           "Drops the cells kept and resets the counters.");
 
   implement_bicubic<double>(m, "Float64");
   implement_bicubic<float>(m, "Float32");
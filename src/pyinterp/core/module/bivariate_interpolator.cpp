@@ -9,6 +9,16 @@ namespace py = pybind11;
 namespace geometry = pyinterp::detail::geometry;
 
 void init_bivariate_interpolator(py::module& m) {
+  py::enum_<pyinterp::detail::math::Distance>(m, "Distance", R"__doc__(
+Method used to calculate the distances between the points.
+)__doc__")
+      .value("Haversine", pyinterp::detail::math::kHaversine,
+             "*Haversine formula*.")
+      .value("Equirectangular", pyinterp::detail::math::kEquirectangular,
+             "*Local equirectangular approximation, faster, whose relative "
+             "error on the distances is about 4e-5 for cells of one degree "
+             "and 2.5e-6 for cells of a quarter of a degree*.");
+
   pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint2D,
                                              double>(m, "", "2D");
   pyinterp::implement_bivariate_interpolator<geometry::EquatorialPoint3D,
@@ -50,6 +50,7 @@ Return:
         py::arg("is_circle") = true, py::arg("max_iterations") = 2000,
         py::arg("epsilon") = 1e-4, py::arg("relaxation") = 1.0,
         py::arg("num_thread") = 0,
+        py::arg("sweep") = pyinterp::fill::kRedBlack,
         R"__doc__(
 Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
 method by relaxation.
@@ -64,13 +65,45 @@ Args:
     epsilon (float, optional): Tolerance for ending relaxation before the
         maximum number of iterations limit. Defaults to ``1e-4``.
     relaxation (float, opional): Relaxation constant. Defaults to ``1``.
-    num_threads (int, optional): The number of threads to use for the
+    num_thread (int, optional): The number of threads to use for the
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    sweep (pyinterp.core.fill.Sweep, optional): Order in which the cells are
+        relaxed. Defaults to ``RedBlack``.
 
 Return:
     tuple: the number of iterations performed and the maximum residual value.
+)__doc__",
+        py::call_guard<py::gil_scoped_release>());
+
+  m.def(("multigrid_" + function_suffix).c_str(),
+        &pyinterp::fill::multigrid<Type>, py::arg("grid"),
+        py::arg("first_guess") = pyinterp::fill::kZonalAverage,
+        py::arg("is_circle") = true, py::arg("max_iterations") = 100,
+        py::arg("epsilon") = 1e-4, py::arg("num_thread") = 0,
+        R"__doc__(
+Replaces all undefined values (NaN) in a grid by solving Poisson's equation
+with a geometric multigrid method.
+
+Args:
+    grid (numpy.ndarray): Grid function on a uniform 2-dimensional grid to be
+        filled.
+    first_guess (pyinterp.core.fill.FirstGuess, optional): Type of first
+        guess grid. Defaults to ``ZonalAverage``.
+    is_circle (bool, optional): True if the X axis of the grid defines a
+        circle. Defaults to ``True``.
+    max_iterations (int, optional): Maximum number of multigrid cycles.
+        Defaults to ``100``.
+    epsilon (float, optional): Tolerance for ending the cycles before the
+        maximum number of iterations limit. Defaults to ``1e-4``.
+    num_thread (int, optional): The number of threads to use for the
+        computation of the first guess. If 0 all CPUs are used. If 1 is
+        given, no parallel computing code is used at all, which is useful for
+        debugging. Defaults to ``0``.
+
+Return:
+    tuple: the number of cycles performed and the maximum residual value.
 )__doc__",
         py::call_guard<py::gil_scoped_release>());
 }
@@ -120,6 +153,15 @@ void init_fill(py::module& m) {
       .value("ZonalAverage", pyinterp::fill::kZonalAverage,
              "Use zonal average in x direction");
 
+  py::enum_<pyinterp::fill::Sweep>(
+      m, "Sweep", "Order in which the Gauss-Seidel method relaxes the cells.")
+      .value("RedBlack", pyinterp::fill::kRedBlack,
+             "*Cells of one colour relaxed concurrently, the result does not "
+             "depend on the number of threads*.")
+      .value("Pipelined", pyinterp::fill::kPipelined,
+             "*Lexicographic order, bands of columns processed by pipelined "
+             "threads*.");
+
   py::enum_<pyinterp::fill::ValueType>(m, "ValueType",
                                        R"__doc__(
 Type of values processed by the loess filter
@@ -0,0 +1,205 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/interpolation_plan.hpp"
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "pyinterp/detail/geometry/point.hpp"
+
+namespace py = pybind11;
+namespace geometry = pyinterp::detail::geometry;
+
+static void implement_bivariate_plan(py::module& m) {
+  using Plan = pyinterp::BivariatePlan<double>;
+
+  py::class_<Plan>(m, "BivariatePlan", R"__doc__(
+Interpolation of bivariate functions, sharing the same axes, at a fixed set
+of points.
+
+The axes are searched and the weights of the interpolator are computed once,
+when the plan is created. Interpolating a grid then only gathers the values
+of the cells containing the points and computes their weighted sum.
+)__doc__")
+      .def(py::init<std::shared_ptr<pyinterp::Axis<double>>,
+                    std::shared_ptr<pyinterp::Axis<double>>,
+                    const py::array_t<double>&, const py::array_t<double>&,
+                    const pyinterp::detail::math::Bivariate<
+                        geometry::EquatorialPoint2D, double>*,
+                    bool, size_t>(),
+           py::arg("x"), py::arg("y"), py::arg("x_values"),
+           py::arg("y_values"), py::arg("interpolator"),
+           py::arg("bounds_error") = false, py::arg("num_threads") = 0,
+           R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis of the grids to interpolate.
+    y (pyinterp.core.Axis): Y-Axis of the grids to interpolate.
+    x_values (numpy.ndarray): X-coordinates of the points.
+    y_values (numpy.ndarray): Y-coordinates of the points.
+    interpolator (pyinterp.core.BivariateInterpolator2D): 2D interpolator
+      used to interpolate.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y), a ValueError
+      is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+      .def_property_readonly(
+          "x", [](const Plan& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const Plan& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def("__len__", &Plan::size)
+      .def("apply", &Plan::apply<double>, py::arg("grid"),
+           py::arg("num_threads") = 0, py::arg("out") = py::none())
+      .def("apply", &Plan::apply<float>, py::arg("grid"),
+           py::arg("num_threads") = 0, py::arg("out") = py::none(),
+           R"__doc__(
+Interpolates the grid at the points of the plan.
+
+Args:
+    grid (pyinterp.core.Grid2DFloat64): Grid containing the values to be
+        interpolated. Its axes must be equal to the axes of the plan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result.
+Return:
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates of the points.
+)__doc__")
+      .def(py::pickle([](const Plan& self) { return self.getstate(); },
+                      [](const py::tuple& state) {
+                        return Plan::setstate(state);
+                      }));
+}
+
+template <template <class> class Point, typename AxisType>
+void implement_trivariate_plan(py::module& m, const std::string& prefix) {
+  using Plan = pyinterp::TrivariatePlan<double, AxisType>;
+
+  py::class_<Plan>(m, (prefix + "TrivariatePlan").c_str(), R"__doc__(
+Interpolation of trivariate functions, sharing the same axes, at a fixed set
+of points.
+
+The axes are searched and the weights of the interpolator are computed once,
+when the plan is created. Interpolating a grid then only gathers the values
+of the cells containing the points and computes their weighted sum.
+)__doc__")
+      .def(py::init<std::shared_ptr<pyinterp::Axis<double>>,
+                    std::shared_ptr<pyinterp::Axis<double>>,
+                    std::shared_ptr<pyinterp::Axis<AxisType>>,
+                    const py::array_t<double>&, const py::array_t<double>&,
+                    const py::array_t<AxisType>&,
+                    const pyinterp::detail::math::Bivariate<Point, double>*,
+                    const std::optional<std::string>&, bool, size_t>(),
+           py::arg("x"), py::arg("y"), py::arg("z"), py::arg("x_values"),
+           py::arg("y_values"), py::arg("z_values"), py::arg("interpolator"),
+           py::arg("z_method") = py::none(), py::arg("bounds_error") = false,
+           py::arg("num_threads") = 0,
+           (R"__doc__(
+Default constructor
+
+Args:
+    x (pyinterp.core.Axis): X-Axis of the grids to interpolate.
+    y (pyinterp.core.Axis): Y-Axis of the grids to interpolate.
+    z (pyinterp.core.)__doc__" +
+            prefix + R"__doc__(Axis): Z-Axis of the grids to interpolate.
+    x_values (numpy.ndarray): X-coordinates of the points.
+    y_values (numpy.ndarray): Y-coordinates of the points.
+    z_values (numpy.ndarray): Z-coordinates of the points.
+    interpolator (pyinterp.core.)__doc__" +
+            prefix + R"__doc__(BivariateInterpolator3D): 3D interpolator
+        used to interpolate values on the surface (x, y, z).
+    z_method (str, optional): The method of interpolation to perform on
+      Z-axis. Supported are ``linear`` and ``nearest``. Default to
+      ``linear``.
+    bounds_error (bool, optional): If True, when interpolated values are
+      requested outside of the domain of the input axes (x,y,z), a ValueError
+      is raised. If False, then value is set to NaN.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+)__doc__")
+               .c_str())
+      .def_property_readonly(
+          "x", [](const Plan& self) { return self.x(); },
+          R"__doc__(
+Gets the X-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: X-Axis
+)__doc__")
+      .def_property_readonly(
+          "y", [](const Plan& self) { return self.y(); },
+          R"__doc__(
+Gets the Y-Axis handled by this instance
+
+Return:
+    pyinterp.core.Axis: Y-Axis
+)__doc__")
+      .def_property_readonly(
+          "z", [](const Plan& self) { return self.z(); },
+          (R"__doc__(
+Gets the Z-Axis handled by this instance
+
+Return:
+    pyinterp.core.)__doc__" +
+           prefix + R"__doc__(Axis: Z-Axis
+)__doc__")
+              .c_str())
+      .def("__len__", &Plan::size)
+      .def("apply", &Plan::template apply<double>, py::arg("grid"),
+           py::arg("num_threads") = 0, py::arg("out") = py::none())
+      .def("apply", &Plan::template apply<float>, py::arg("grid"),
+           py::arg("num_threads") = 0, py::arg("out") = py::none(),
+           (R"__doc__(
+Interpolates the grid at the points of the plan.
+
+Args:
+    grid (pyinterp.core.)__doc__" +
+            prefix + R"__doc__(Grid3DFloat64): Grid containing the values to
+        be interpolated. Its axes must be equal to the axes of the plan.
+    num_threads (int, optional): The number of threads to use for the
+        computation. If 0 all CPUs are used. If 1 is given, no parallel
+        computing code is used at all, which is useful for debugging.
+        Defaults to ``0``.
+    out (numpy.ndarray, optional): Array receiving the values interpolated,
+        instead of a new array: a writable, C-contiguous, array of the type
+        and shape of the result.
+Return:
+    numpy.ndarray: Values interpolated, an array of the shape of the
+    coordinates of the points.
+)__doc__")
+               .c_str())
+      .def(py::pickle([](const Plan& self) { return self.getstate(); },
+                      [](const py::tuple& state) {
+                        return Plan::setstate(state);
+                      }));
+}
+
+void init_interpolation_plan(py::module& m) {
+  implement_bivariate_plan(m);
+  implement_trivariate_plan<geometry::EquatorialPoint3D, double>(m, "");
+  implement_trivariate_plan<geometry::TemporalEquatorial2D, int64_t>(
+      m, "Temporal");
+}
@@ -15,8 +15,10 @@ extern void init_bivariate(py::module&);
 extern void init_fill(py::module&);
 extern void init_geodetic(py::module&);
 extern void init_grid(py::module&);
+extern void init_interpolation_plan(py::module&);
 extern void init_quadrivariate(py::module&);
 extern void init_rtree(py::module&);
+extern void init_shared_memory(py::module&);
 extern void init_trivariate(py::module&);
 
 PYBIND11_MODULE(core, m) {
@@ -45,7 +47,9 @@ Replace undefined values
   init_trivariate(m);
   init_quadrivariate(m);
   init_bicubic(m);
+  init_interpolation_plan(m);
   init_geodetic(geodetic);
   init_fill(fill);
   init_rtree(m);
+  init_shared_memory(m);
 }
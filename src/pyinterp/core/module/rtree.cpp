@@ -107,11 +107,12 @@ Args:
       .def("query",
            [](const pyinterp::RTree<CoordinateType, Type, N>& self,
               const py::array_t<CoordinateType>& coordinates, const uint32_t k,
-              const bool within, const size_t num_threads) -> py::tuple {
-             return self.query(coordinates, k, within, num_threads);
+              const bool within, const size_t num_threads,
+              const pyinterp::OutputPair& out) -> py::tuple {
+             return self.query(coordinates, k, within, num_threads, out);
            },
            py::arg("coordinates"), py::arg("k") = 4, py::arg("within") = false,
-           py::arg("num_threads") = 0,
+           py::arg("num_threads") = 0, py::arg("out") = py::none(),
            (R"__doc__(
 Search for the nearest K nearest neighbors of a given point.
 
@@ -127,6 +128,9 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (tuple, optional): Pair of arrays receiving the results, instead of
+        new arrays: writable, C-contiguous, arrays of the type and shape of
+        the results. They must not overlap the coordinates.
 Return:
     tuple: A tuple containing a matrix describing for each provided position,
     the distance, in meters, between the provided position and the found
@@ -139,7 +143,7 @@ Return:
           &pyinterp::RTree<CoordinateType, Type, N>::inverse_distance_weighting,
           py::arg("coordinates"), py::arg("radius"), py::arg("k") = 9,
           py::arg("p") = 2, py::arg("within") = true,
-          py::arg("num_threads") = 0,
+          py::arg("num_threads") = 0, py::arg("out") = py::none(),
           (R"__doc__(
 Interpolation of the value at the requested position by inverse distance
 weighting method.
@@ -160,6 +164,9 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (tuple, optional): Pair of arrays receiving the results, instead of
+        new arrays: writable, C-contiguous, arrays of the type and shape of
+        the results. They must not overlap the coordinates.
 Return:
     tuple: The interpolated value and the number of neighbors used in the
     calculation.
@@ -173,7 +180,7 @@ Return:
           py::arg("epsilon") = std::optional<
               typename pyinterp::RTree<CoordinateType, Type, N>::promotion_t>(),
           py::arg("smooth") = 0, py::arg("within") = true,
-          py::arg("num_threads") = 0,
+          py::arg("num_threads") = 0, py::arg("out") = py::none(),
           (R"__doc__(
 Interpolation of the value at the requested position by radial basis function
 interpolation.
@@ -198,6 +205,9 @@ Args:
         computation. If 0 all CPUs are used. If 1 is given, no parallel
         computing code is used at all, which is useful for debugging.
         Defaults to ``0``.
+    out (tuple, optional): Pair of arrays receiving the results, instead of
+        new arrays: writable, C-contiguous, arrays of the type and shape of
+        the results. They must not overlap the coordinates.
 Return:
     tuple: The interpolated value and the number of neighbors used for the
     calculation.
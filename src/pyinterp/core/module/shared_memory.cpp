@@ -0,0 +1,76 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <pybind11/pybind11.h>
+#include "pyinterp/detail/shared_memory.hpp"
+
+namespace py = pybind11;
+
+void init_shared_memory(py::module& m) {
+  py::class_<pyinterp::detail::SharedMemory>(m, "SharedMemory",
+                                             py::buffer_protocol(), R"__doc__(
+Named POSIX shared memory segment.
+
+The segment is destroyed when the last instance referencing it, in all the
+processes attached to it, is released.
+)__doc__")
+      .def_static("create", &pyinterp::detail::SharedMemory::create,
+                  py::arg("name"), py::arg("size"), R"__doc__(
+Creates a new shared memory segment.
+
+Args:
+    name (str): Name of the segment, for example ``/my_grid``.
+    size (int): Size of the data, in bytes, stored in the segment.
+Return:
+    pyinterp.core.SharedMemory: The segment created.
+)__doc__")
+      .def_static("attach", &pyinterp::detail::SharedMemory::attach,
+                  py::arg("name"), R"__doc__(
+Attaches an existing shared memory segment.
+
+Args:
+    name (str): Name of the segment.
+Return:
+    pyinterp.core.SharedMemory: The segment attached.
+)__doc__")
+      .def_static("unlink", &pyinterp::detail::SharedMemory::unlink,
+                  py::arg("name"), R"__doc__(
+Removes the name of a segment from the system, for example to clean up a
+segment left by a process that was killed. The processes already attached to
+the segment can still access it.
+
+Args:
+    name (str): Name of the segment.
+Return:
+    bool: True if the segment was removed.
+)__doc__")
+      .def_property_readonly("name", &pyinterp::detail::SharedMemory::name,
+                             R"__doc__(
+Gets the name of the segment
+
+Return:
+    str: name of the segment
+)__doc__")
+      .def_property_readonly("size", &pyinterp::detail::SharedMemory::size,
+                             R"__doc__(
+Gets the size of the data stored in the segment
+
+Return:
+    int: size in bytes
+)__doc__")
+      .def_property_readonly("ref_count",
+                             &pyinterp::detail::SharedMemory::ref_count,
+                             R"__doc__(
+Gets the number of instances, in all processes, attached to the segment
+
+Return:
+    int: reference count
+)__doc__")
+      .def_buffer([](pyinterp::detail::SharedMemory& self) -> py::buffer_info {
+        return py::buffer_info(
+            self.data(), sizeof(uint8_t),
+            py::format_descriptor<uint8_t>::format(), 1,
+            {static_cast<py::ssize_t>(self.size())}, {sizeof(uint8_t)});
+      });
+}
@@ -687,3 +687,15 @@ TYPED_TEST(AxisTest, search_window) {
   indexes = axis.find_indexes(9, 4, pyinterp::axis::kUndef);
   ASSERT_TRUE(indexes.empty());
 }
+
+TEST(axis, search) {
+  auto axis = detail::Axis<double>(0, 9, 10, 1e-6, false);
+  auto search = detail::AxisSearch<double>(axis);
+
+  for (auto coordinate : {2.5, 2.5, 7.25, 7.25, 2.5, 9.5, 9.5, 0.0}) {
+    EXPECT_EQ(search.find_indexes(coordinate), axis.find_indexes(coordinate));
+  }
+  EXPECT_FALSE(search.find_indexes(-1).has_value());
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(search.find_indexes(nan).has_value());
+}
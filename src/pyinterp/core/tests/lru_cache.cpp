@@ -0,0 +1,63 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include "pyinterp/detail/lru_cache.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include "pyinterp/detail/thread.hpp"
+
+using LruCache = pyinterp::detail::LruCache<int, std::string>;
+
+TEST(lru_cache, find) {
+  auto cache = LruCache(2);
+  EXPECT_EQ(cache.capacity(), 2);
+  EXPECT_FALSE(cache.find(1).has_value());
+
+  cache.insert(1, "one");
+  cache.insert(2, "two");
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(*cache.find(1), "one");
+  EXPECT_EQ(*cache.find(2), "two");
+  EXPECT_EQ(cache.hits(), 2);
+  EXPECT_EQ(cache.misses(), 1);
+
+  // The least recently used value is dropped
+  EXPECT_EQ(*cache.find(1), "one");
+  cache.insert(3, "three");
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_FALSE(cache.find(2).has_value());
+  EXPECT_EQ(*cache.find(1), "one");
+  EXPECT_EQ(*cache.find(3), "three");
+
+  // The value of a key kept is replaced
+  cache.insert(3, "3");
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(*cache.find(3), "3");
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.hits(), 0);
+  EXPECT_EQ(cache.misses(), 0);
+
+  EXPECT_THROW(LruCache(0), std::invalid_argument);
+}
+
+TEST(lru_cache, threads) {
+  auto cache = LruCache(16);
+  pyinterp::detail::dispatch(
+      [&cache](size_t start, size_t end) {
+        for (auto ix = start; ix < end; ++ix) {
+          auto key = static_cast<int>(ix % 32);
+          auto value = cache.find(key);
+          if (value) {
+            EXPECT_EQ(*value, std::to_string(key));
+          } else {
+            cache.insert(key, std::to_string(key));
+          }
+        }
+      },
+      4096, 4);
+  EXPECT_EQ(cache.size(), 16);
+  EXPECT_EQ(cache.hits() + cache.misses(), 4096);
+}
@@ -33,6 +33,14 @@ TEST(math, sqr) {
   EXPECT_DOUBLE_EQ(math::sqr(math::pi<double>()), M_PI * M_PI);
 }
 
+TEST(math, ipow) {
+  EXPECT_DOUBLE_EQ(math::ipow(1.5, 0), 1);
+  EXPECT_DOUBLE_EQ(math::ipow(1.5, 1), 1.5);
+  EXPECT_DOUBLE_EQ(math::ipow(1.5, 2), 2.25);
+  EXPECT_DOUBLE_EQ(math::ipow(1.5, 5), std::pow(1.5, 5));
+  EXPECT_DOUBLE_EQ(math::ipow(2.0, -3), 0.125);
+}
+
 TEST(math, normalize_angle) {
   // normalize_angle(x + kπ) == x
   EXPECT_NEAR(math::normalize_angle(720.001, -180.0, 360.0), 0.001, 1e-12);
@@ -83,8 +83,8 @@ TEST(math_bicubic, xarray_3d) {
   }
 
   auto xr0 = xr.xarray_2d(0);
-  EXPECT_EQ(xr0.x(), xr.x());
-  EXPECT_EQ(xr0.y(), xr.y());
+  EXPECT_EQ(xr0.x(), xr.x().get());
+  EXPECT_EQ(xr0.y(), xr.y().get());
 
   for (auto ix = 0; ix < 6; ++ix) {
     for (auto iy = 0; iy < 8; ++iy) {
@@ -144,8 +144,8 @@ TEST(math_bicubic, xarray_4d) {
   }
 
   auto xr0 = xr.xarray_2d(0, 0);
-  EXPECT_EQ(xr0.x(), xr.x());
-  EXPECT_EQ(xr0.y(), xr.y());
+  EXPECT_EQ(xr0.x(), xr.x().get());
+  EXPECT_EQ(xr0.y(), xr.y().get());
 
   for (auto ix = 0; ix < 6; ++ix) {
     for (auto iy = 0; iy < 8; ++iy) {
@@ -182,3 +182,80 @@ TEST(math_bicubic, bicubic) {
     }
   }
 }
+
+TEST(math_bicubic, gradient) {
+  auto xr = math::XArray2D(3, 3);
+
+  // A plane is reproduced exactly by the natural cubic splines
+  for (auto ix = 0; ix < 6; ++ix) {
+    xr.x(ix) = xr.y(ix) = ix * 0.1;
+  }
+  for (auto ix = 0; ix < 6; ++ix) {
+    for (auto iy = 0; iy < 6; ++iy) {
+      xr.q(ix, iy) = 2 * xr.x(ix) - 3 * xr.y(iy);
+    }
+  }
+
+  auto interpolator = math::Bicubic(xr, gsl_interp_cspline);
+  for (auto x : {0.12, 0.25, 0.31}) {
+    for (auto y : {0.05, 0.22, 0.43}) {
+      auto gradient = interpolator.gradient(x, y, xr);
+      EXPECT_DOUBLE_EQ(gradient[0], interpolator.interpolate(x, y, xr));
+      EXPECT_NEAR(gradient[0], 2 * x - 3 * y, 1e-12);
+      EXPECT_NEAR(gradient[1], 2, 1e-12);
+      EXPECT_NEAR(gradient[2], -3, 1e-12);
+      EXPECT_NEAR(gradient[3], 0, 1e-12);
+    }
+  }
+}
+
+TEST(math_bicubic, refit) {
+  auto xr = math::XArray2D(3, 3);
+  for (auto ix = 0; ix < 6; ++ix) {
+    xr.x(ix) = xr.y(ix) = ix * 0.1;
+  }
+  for (auto ix = 0; ix < 6; ++ix) {
+    for (auto iy = 0; iy < 6; ++iy) {
+      xr.q(ix, iy) = std::sin(xr.x(ix)) * std::cos(xr.y(iy));
+    }
+  }
+
+  // The splines fitted on the rows are reused while the window is unchanged
+  auto cached = math::Bicubic(xr, gsl_interp_cspline);
+  auto interpolator = math::Bicubic(xr, gsl_interp_cspline);
+  auto refit = true;
+  for (auto x : {0.12, 0.25, 0.31}) {
+    for (auto y : {0.05, 0.22, 0.43}) {
+      EXPECT_EQ(cached.interpolate(x, y, xr, refit),
+                interpolator.interpolate(x, y, xr));
+      refit = false;
+    }
+  }
+
+  // Another window: the rows must be fitted again
+  xr.q().array() *= 2;
+  EXPECT_EQ(cached.interpolate(0.25, 0.22, xr, true),
+            interpolator.interpolate(0.25, 0.22, xr));
+}
+
+TEST(math_bicubic, layer_interpolator) {
+  // Two layers: linear interpolation
+  auto linear = math::LayerInterpolator<double>(1, gsl_interp_cspline);
+  auto z = Eigen::VectorXd(2);
+  z << 1, 3;
+  linear.values() << 2, 6;
+  EXPECT_DOUBLE_EQ(linear.interpolate(z, 2.5), 5);
+
+  // Four layers: a straight line is reproduced exactly by the natural cubic
+  // splines, also for dates that cannot be converted to double without
+  // being rounded.
+  auto spline = math::LayerInterpolator<int64_t>(2, gsl_interp_cspline);
+  auto dates = Eigen::Matrix<int64_t, Eigen::Dynamic, 1>(4);
+  auto origin = static_cast<int64_t>(1577836800000000001);
+  for (auto ix = 0; ix < 4; ++ix) {
+    dates(ix) = origin + ix * 3600000000000LL;
+    spline.values()(ix) = ix * 2.0 - 1;
+  }
+  EXPECT_NEAR(spline.interpolate(dates, origin + 5400000000000LL), 2, 1e-12);
+  EXPECT_NEAR(spline.interpolate(dates, origin + 1), -1, 1e-12);
+}
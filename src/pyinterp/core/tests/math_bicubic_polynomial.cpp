@@ -0,0 +1,38 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+#include "pyinterp/detail/math/bicubic_polynomial.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_bicubic_polynomial, coefficients) {
+  // p(t, u) = 1 - 2t + 3tu² - t³u³ + 0.5t²u
+  auto p = [](const double t, const double u) {
+    return 1 - 2 * t + 3 * t * u * u - t * t * t * u * u * u + 0.5 * t * t * u;
+  };
+  auto f = std::array<double, 16>();
+  for (auto ix = 0; ix < 4; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      f[ix * 4 + jx] =
+          p(math::kBicubicSamples[ix], math::kBicubicSamples[jx]);
+    }
+  }
+  auto a = math::bicubic_polynomial(f);
+  auto expected = std::array<double, 16>();
+  expected[0] = 1;
+  expected[4] = -2;
+  expected[4 + 2] = 3;
+  expected[12 + 3] = -1;
+  expected[8 + 1] = 0.5;
+  for (auto ix = 0; ix < 16; ++ix) {
+    EXPECT_NEAR(a[ix], expected[ix], 1e-12);
+  }
+
+  for (auto t : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+    for (auto u : {0.0, 0.3, 0.75, 1.0}) {
+      EXPECT_NEAR(math::evaluate_bicubic_polynomial(a, t, u), p(t, u), 1e-14);
+    }
+  }
+}
@@ -31,6 +31,31 @@ TEST(math_bivariate, bilinear) {
                    128.5);
 }
 
+TEST(math_bivariate, bilinear_gradient) {
+  auto interpolator = math::Bilinear<geometry::Point2D, double>();
+  auto p0 = geometry::Point2D<double>{14.0, 21.0};
+  auto p1 = geometry::Point2D<double>{15.0, 20.0};
+
+  auto gradient = interpolator.gradient(geometry::Point2D<double>{14.5, 20.2},
+                                        p0, p1, 162.0, 91.0, 95.0, 210.0);
+  EXPECT_DOUBLE_EQ(gradient[0], 146.1);
+  EXPECT_NEAR(gradient[1], 81.8, 1e-9);
+  EXPECT_NEAR(gradient[2], -22.0, 1e-9);
+  EXPECT_NEAR(gradient[3], -186.0, 1e-9);
+
+  // The derivatives are those of the interpolated surface
+  auto dx = interpolator.evaluate(geometry::Point2D<double>{14.6, 20.2}, p0,
+                                  p1, 162.0, 91.0, 95.0, 210.0) -
+            interpolator.evaluate(geometry::Point2D<double>{14.4, 20.2}, p0,
+                                  p1, 162.0, 91.0, 95.0, 210.0);
+  EXPECT_NEAR(gradient[1], dx / 0.2, 1e-9);
+  auto dy = interpolator.evaluate(geometry::Point2D<double>{14.5, 20.3}, p0,
+                                  p1, 162.0, 91.0, 95.0, 210.0) -
+            interpolator.evaluate(geometry::Point2D<double>{14.5, 20.1}, p0,
+                                  p1, 162.0, 91.0, 95.0, 210.0);
+  EXPECT_NEAR(gradient[2], dy / 0.2, 1e-9);
+}
+
 TEST(math_bivariate, nearest) {
   auto interpolator = math::Nearest<geometry::Point2D, double>();
 
@@ -93,3 +118,59 @@ TEST(math_bivariate, idw) {
                             geometry::Point2D<double>{1, 1}, 0, 1, 2, 3),
       1.5);
 }
+
+TEST(math_bivariate, equirectangular) {
+  using Point = geometry::EquatorialPoint2D<double>;
+  auto p = Point{10.3, 60.8};
+  auto p0 = Point{10, 60};
+  auto p1 = Point{11, 61};
+
+  auto exact = math::corner_distances<geometry::EquatorialPoint2D, double>(
+      p, p0, p1, math::kHaversine, false);
+  auto approx = math::corner_distances<geometry::EquatorialPoint2D, double>(
+      p, p0, p1, math::kEquirectangular, false);
+  for (size_t ix = 0; ix < exact.size(); ++ix) {
+    EXPECT_NEAR(approx[ix] / exact[ix], 1, 5e-5);
+  }
+
+  using IDW =
+      math::InverseDistanceWeighting<geometry::EquatorialPoint2D, double>;
+  auto idw = IDW(3, math::kEquirectangular);
+  EXPECT_EQ(idw.distance(), math::kEquirectangular);
+  EXPECT_NEAR(idw.evaluate(p, p0, p1, 0, 1, 2, 3),
+              IDW(3).evaluate(p, p0, p1, 0, 1, 2, 3), 1e-4);
+  EXPECT_DOUBLE_EQ(idw.evaluate(p0, p0, p1, 0, 1, 2, 3), 0);
+
+  auto nearest = math::Nearest<geometry::EquatorialPoint2D, double>(
+      math::kEquirectangular);
+  EXPECT_DOUBLE_EQ(nearest.evaluate(p, p0, p1, 0, 1, 2, 3), 1);
+}
+
+TEST(math_bivariate, evaluate_variables) {
+  auto bilinear = math::Bilinear<geometry::Point2D, double>();
+  auto nearest = math::Nearest<geometry::Point2D, double>();
+  auto idw = math::InverseDistanceWeighting<geometry::Point2D, double>();
+  auto interpolators =
+      std::vector<const math::Bivariate<geometry::Point2D, double>*>{
+          &bilinear, &nearest, &idw};
+
+  auto p0 = geometry::Point2D<double>{14.0, 21.0};
+  auto p1 = geometry::Point2D<double>{15.0, 20.0};
+  auto q = Eigen::Matrix<double, Eigen::Dynamic, 4>(3, 4);
+  q << 162.0, 91.0, 95.0, 210.0, -1.0, 2.0, 3.0, -4.0, 0.0, 1.0, 2.0, 3.0;
+  auto result = Eigen::VectorXd(3);
+
+  for (auto&& p : {geometry::Point2D<double>{14.5, 20.2},
+                   geometry::Point2D<double>{14.0, 21.0},
+                   geometry::Point2D<double>{14.9, 20.0}}) {
+    for (auto&& item : interpolators) {
+      item->evaluate_variables(p, p0, p1, q, result);
+      for (Eigen::Index ix = 0; ix < q.rows(); ++ix) {
+        EXPECT_NEAR(result(ix),
+                    item->evaluate(p, p0, p1, q(ix, 0), q(ix, 1), q(ix, 2),
+                                   q(ix, 3)),
+                    1e-12);
+      }
+    }
+  }
+}
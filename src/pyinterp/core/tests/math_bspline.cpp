@@ -0,0 +1,98 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "pyinterp/detail/math/bspline.hpp"
+
+namespace math = pyinterp::detail::math;
+
+// Value of the spline on the node ix, the coefficients being extended by
+// mirror symmetry or periodically.
+static auto node_value(const Eigen::VectorXd& c, const Eigen::Index ix,
+                       const bool periodic) -> double {
+  const auto n = c.size();
+  auto before = ix - 1;
+  auto after = ix + 1;
+  if (periodic) {
+    before = (before + n) % n;
+    after = after % n;
+  } else {
+    before = before < 0 ? 1 : before;
+    after = after == n ? n - 2 : after;
+  }
+  return (c(before) + 4 * c(ix) + c(after)) / 6;
+}
+
+TEST(math_bspline, weights) {
+  auto w = math::bspline_weights(0);
+  EXPECT_DOUBLE_EQ(w[0], 1.0 / 6.0);
+  EXPECT_DOUBLE_EQ(w[1], 4.0 / 6.0);
+  EXPECT_DOUBLE_EQ(w[2], 1.0 / 6.0);
+  EXPECT_DOUBLE_EQ(w[3], 0);
+  w = math::bspline_weights(1);
+  EXPECT_DOUBLE_EQ(w[0], 0);
+  EXPECT_DOUBLE_EQ(w[1], 1.0 / 6.0);
+  EXPECT_DOUBLE_EQ(w[2], 4.0 / 6.0);
+  EXPECT_DOUBLE_EQ(w[3], 1.0 / 6.0);
+
+  for (auto t = 0.0; t <= 1.0; t += 0.125) {
+    w = math::bspline_weights(t);
+    EXPECT_NEAR(w[0] + w[1] + w[2] + w[3], 1, 1e-15);
+    EXPECT_NEAR(-w[0] + w[2] + 2 * w[3], t, 1e-15);
+  }
+}
+
+TEST(math_bspline, prefilter) {
+  for (auto periodic : {false, true}) {
+    for (auto n : {2, 3, 10, 100}) {
+      auto values = Eigen::VectorXd(n);
+      for (auto ix = 0; ix < n; ++ix) {
+        values(ix) = std::sin(ix * 0.7) + 0.1 * ix;
+      }
+      Eigen::VectorXd c = values;
+      math::bspline_prefilter(c, periodic);
+      for (auto ix = 0; ix < n; ++ix) {
+        EXPECT_NEAR(node_value(c, ix, periodic), values(ix), 1e-12);
+      }
+    }
+  }
+}
+
+TEST(math_bspline, prefilter_nan) {
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  for (auto periodic : {false, true}) {
+    auto values = Eigen::VectorXd(12);
+    values << 1, 2, 4, nan, 3, 5, 2, 7, nan, nan, 1, 3;
+    Eigen::VectorXd c = values;
+    math::bspline_prefilter(c, periodic);
+
+    // Each segment is interpolated independently.
+    auto check = [&](const Eigen::Index start, const Eigen::Index size) {
+      Eigen::VectorXd segment = values.segment(start, size);
+      math::bspline_prefilter(segment, false);
+      for (auto ix = 0; ix < size; ++ix) {
+        EXPECT_DOUBLE_EQ(c(start + ix), segment(ix));
+      }
+    };
+    check(4, 4);
+    EXPECT_TRUE(std::isnan(c(3)));
+    EXPECT_TRUE(std::isnan(c(8)));
+    EXPECT_TRUE(std::isnan(c(9)));
+    if (periodic) {
+      // The last segment continues at the beginning of the line.
+      auto segment = Eigen::VectorXd(5);
+      segment << 1, 3, 1, 2, 4;
+      math::bspline_prefilter(segment, false);
+      EXPECT_DOUBLE_EQ(c(10), segment(0));
+      EXPECT_DOUBLE_EQ(c(11), segment(1));
+      EXPECT_DOUBLE_EQ(c(0), segment(2));
+      EXPECT_DOUBLE_EQ(c(2), segment(4));
+    } else {
+      check(0, 3);
+      check(10, 2);
+    }
+  }
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "pyinterp/detail/math/cubic_convolution.hpp"
+
+namespace math = pyinterp::detail::math;
+
+TEST(math_cubic_convolution, weights) {
+  // The kernel interpolates the nodes
+  auto w = math::cubic_convolution_weights(0);
+  EXPECT_DOUBLE_EQ(w[0], 0);
+  EXPECT_DOUBLE_EQ(w[1], 1);
+  EXPECT_DOUBLE_EQ(w[2], 0);
+  EXPECT_DOUBLE_EQ(w[3], 0);
+  w = math::cubic_convolution_weights(1);
+  EXPECT_DOUBLE_EQ(w[0], 0);
+  EXPECT_DOUBLE_EQ(w[1], 0);
+  EXPECT_DOUBLE_EQ(w[2], 1);
+  EXPECT_DOUBLE_EQ(w[3], 0);
+
+  // Symmetry at the middle of the cell
+  w = math::cubic_convolution_weights(0.5);
+  EXPECT_DOUBLE_EQ(w[0], -0.0625);
+  EXPECT_DOUBLE_EQ(w[1], 0.5625);
+  EXPECT_DOUBLE_EQ(w[2], 0.5625);
+  EXPECT_DOUBLE_EQ(w[3], -0.0625);
+
+  // Partition of unity, and exact reproduction of the polynomials of degree
+  // two.
+  for (auto t = 0.0; t <= 1.0; t += 0.125) {
+    w = math::cubic_convolution_weights(t);
+    EXPECT_NEAR(w[0] + w[1] + w[2] + w[3], 1, 1e-15);
+    EXPECT_NEAR(-w[0] + w[2] + 2 * w[3], t, 1e-15);
+    EXPECT_NEAR(w[0] + w[2] + 4 * w[3], t * t, 1e-15);
+  }
+}
+
+TEST(math_cubic_convolution, convolve) {
+  auto convolve = [](const std::array<double, 16>& q, const double tx,
+                     const double ty) {
+    return math::convolve(q, math::cubic_convolution_weights(tx),
+                          math::cubic_convolution_weights(ty));
+  };
+
+  // f(x, y) = x² + xy - 2y on the nodes x, y = -1, 0, 1, 2
+  auto q = std::array<double, 16>();
+  for (auto ix = 0; ix < 4; ++ix) {
+    for (auto jx = 0; jx < 4; ++jx) {
+      auto x = ix - 1.0;
+      auto y = jx - 1.0;
+      q[ix * 4 + jx] = x * x + x * y - 2 * y;
+    }
+  }
+  EXPECT_DOUBLE_EQ(convolve(q, 0, 0), 0);
+  EXPECT_DOUBLE_EQ(convolve(q, 1, 1), 0);
+  EXPECT_DOUBLE_EQ(convolve(q, 0.25, 0.75), -1.25);
+
+  q[0] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(std::isnan(convolve(q, 0.25, 0.75)));
+}
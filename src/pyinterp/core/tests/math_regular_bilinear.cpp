@@ -0,0 +1,125 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "pyinterp/detail/axis.hpp"
+#include "pyinterp/detail/geometry/point.hpp"
+#include "pyinterp/detail/math/bivariate.hpp"
+#include "pyinterp/detail/math/regular_bilinear.hpp"
+
+namespace detail = pyinterp::detail;
+namespace math = pyinterp::detail::math;
+namespace geometry = pyinterp::detail::geometry;
+
+// Interpolation performed by the generic path: the axes are searched and the
+// value is calculated by the bilinear interpolator.
+static auto reference(const detail::Axis<double>& x_axis,
+                      const detail::Axis<double>& y_axis,
+                      const std::vector<double>& grid, const double x,
+                      const double y) -> double {
+  auto x_indexes = x_axis.find_indexes(x);
+  auto y_indexes = y_axis.find_indexes(y);
+  if (!x_indexes.has_value() || !y_indexes.has_value()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  auto [ix0, ix1] = *x_indexes;
+  auto [iy0, iy1] = *y_indexes;
+  auto x0 = x_axis(ix0);
+  auto x1 = x_axis(ix1);
+  auto xi = x;
+  if (x_axis.is_angle()) {
+    xi = math::normalize_angle(x, x0, 360.0);
+    x1 = math::normalize_angle(x1, x0, 360.0);
+  }
+  auto ny = y_axis.size();
+  return math::Bilinear<geometry::Point2D, double>().evaluate(
+      geometry::Point2D<double>(xi, y),
+      geometry::Point2D<double>(x0, y_axis(iy0)),
+      geometry::Point2D<double>(x1, y_axis(iy1)), grid[ix0 * ny + iy0],
+      grid[ix0 * ny + iy1], grid[ix1 * ny + iy0], grid[ix1 * ny + iy1]);
+}
+
+static void check(const detail::Axis<double>& x_axis,
+                  const detail::Axis<double>& y_axis, std::vector<double> x,
+                  std::vector<double> y) {
+  auto nx = x_axis.size();
+  auto ny = y_axis.size();
+  auto grid = std::vector<double>(nx * ny);
+  for (int64_t ix = 0; ix < nx; ++ix) {
+    for (int64_t iy = 0; iy < ny; ++iy) {
+      grid[ix * ny + iy] = std::sin(ix * 0.1) * std::cos(iy * 0.05) * 100;
+    }
+  }
+
+  ASSERT_TRUE(math::RegularBilinear<double>::is_suitable(x_axis, y_axis));
+  auto interpolator = math::RegularBilinear<double>(x_axis, y_axis);
+  auto result = std::vector<double>(x.size());
+  for (size_t ix = 0; ix < x.size();
+       ix += math::RegularBilinear<double>::kBlockSize) {
+    interpolator.evaluate(
+        x.data() + ix, y.data() + ix,
+        std::min(math::RegularBilinear<double>::kBlockSize, x.size() - ix),
+        [&](int64_t i, int64_t j) { return grid[i * ny + j]; },
+        result.data() + ix);
+  }
+
+  for (size_t ix = 0; ix < x.size(); ++ix) {
+    auto expected = reference(x_axis, y_axis, grid, x[ix], y[ix]);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result[ix])) << x[ix] << ", " << y[ix];
+    } else {
+      EXPECT_NEAR(result[ix], expected, 1e-10) << x[ix] << ", " << y[ix];
+    }
+  }
+}
+
+static auto points(const size_t size, const double x_min, const double x_max,
+                   const double y_min, const double y_max)
+    -> std::pair<std::vector<double>, std::vector<double>> {
+  auto generator = std::mt19937(0);
+  auto x_distribution = std::uniform_real_distribution<double>(x_min, x_max);
+  auto y_distribution = std::uniform_real_distribution<double>(y_min, y_max);
+  auto x = std::vector<double>(size);
+  auto y = std::vector<double>(size);
+  for (size_t ix = 0; ix < size; ++ix) {
+    x[ix] = x_distribution(generator);
+    y[ix] = y_distribution(generator);
+  }
+  return std::make_pair(x, y);
+}
+
+TEST(math_regular_bilinear, circle) {
+  auto x_axis = detail::Axis<double>(-180, 179.75, 1440, 1e-6, true);
+  auto y_axis = detail::Axis<double>(-90, 90, 721, 1e-6, false);
+  auto [x, y] = points(10000, -540, 540, -95, 95);
+  // Points located on the nodes, on the boundaries and in the cell
+  // connecting the last and the first longitude.
+  x.insert(x.end(), {-180, 179.75, 179.8, 179.99, 180, -180.1, 0, 0.25, 360});
+  y.insert(y.end(), {-90, 90, 0, 45.5, 90, -90, 0.25, 89.9, -89.9});
+  check(x_axis, y_axis, x, y);
+}
+
+TEST(math_regular_bilinear, descending) {
+  auto x_axis = detail::Axis<double>(30, -10, 81, 1e-6, false);
+  auto y_axis = detail::Axis<double>(90, -90, 361, 1e-6, false);
+  auto [x, y] = points(10000, -20, 40, -95, 95);
+  x.insert(x.end(), {30, -10, 29.9, -9.99, -10, 0, 370});
+  y.insert(y.end(), {90, -90, 0, 90, -90, 0.5, -89.5});
+  check(x_axis, y_axis, x, y);
+
+  x_axis = detail::Axis<double>(180, -179.75, 1440, 1e-6, true);
+  EXPECT_FALSE(math::RegularBilinear<double>::is_suitable(x_axis, y_axis));
+}
+
+TEST(math_regular_bilinear, bounded) {
+  auto x_axis = detail::Axis<double>(-10, 30, 81, 1e-6, false);
+  auto y_axis = detail::Axis<double>(0, 20, 41, 1e-6, false);
+  auto [x, y] = points(10000, -20, 40, -5, 25);
+  x.insert(x.end(), {-10, 30, 30, -10, std::nan("")});
+  y.insert(y.end(), {0, 20, 0, 20, 10});
+  check(x_axis, y_axis, x, y);
+}
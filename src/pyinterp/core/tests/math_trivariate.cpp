@@ -46,3 +46,27 @@ TEST(math_trivariate, trivariate) {
       191.0, 195.0, 310.0, &bilinear, &math::nearest<double, double>);
   EXPECT_DOUBLE_EQ(interpolated, 246.1);
 }
+
+TEST(math_trivariate, trivariate_variables) {
+  auto interpolator = math::Bilinear<geometry::Point3D, double>();
+  auto q0 = Eigen::Matrix<double, Eigen::Dynamic, 4>(2, 4);
+  auto q1 = Eigen::Matrix<double, Eigen::Dynamic, 4>(2, 4);
+  q0 << 0, 0, 0, 0, 1, 2, 3, 4;
+  q1 << 1, 1, 1, 1, 5, 6, 7, 8;
+  auto buffer = Eigen::VectorXd(2);
+  auto result = Eigen::VectorXd(2);
+
+  auto p = geometry::Point3D<double>{0.5, 0.5, 0.5};
+  auto p0 = geometry::Point3D<double>{0, 0, 0};
+  auto p1 = geometry::Point3D<double>{1, 1, 1};
+  math::trivariate_variables<geometry::Point3D, double>(
+      p, p0, p1, q0, q1, &interpolator, &math::linear<double, double>, buffer,
+      result);
+  for (Eigen::Index ix = 0; ix < 2; ++ix) {
+    EXPECT_DOUBLE_EQ(result(ix),
+                     (math::trivariate<geometry::Point3D, double>(
+                         p, p0, p1, q0(ix, 0), q0(ix, 1), q0(ix, 2), q0(ix, 3),
+                         q1(ix, 0), q1(ix, 1), q1(ix, 2), q1(ix, 3),
+                         &interpolator)));
+  }
+}
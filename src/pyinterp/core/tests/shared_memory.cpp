@@ -0,0 +1,44 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+#include <cstring>
+#include <system_error>
+#include <unistd.h>
+#include "pyinterp/detail/shared_memory.hpp"
+
+namespace detail = pyinterp::detail;
+
+TEST(shared_memory, life_cycle) {
+  auto name = "/pyinterp_test_" + std::to_string(getpid());
+  detail::SharedMemory::unlink(name);
+  {
+    auto segment = detail::SharedMemory::create(name, 1024);
+    EXPECT_EQ(segment.name(), name);
+    EXPECT_EQ(segment.size(), 1024);
+    EXPECT_EQ(segment.ref_count(), 1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(segment.data()) %
+                  detail::SharedMemory::kAlignment,
+              0);
+    std::memset(segment.data(), 42, segment.size());
+
+    // A segment cannot be created twice
+    EXPECT_THROW(detail::SharedMemory::create(name, 1024), std::system_error);
+    {
+      auto other = detail::SharedMemory::attach(name);
+      EXPECT_EQ(other.size(), 1024);
+      EXPECT_EQ(segment.ref_count(), 2);
+      EXPECT_EQ(static_cast<uint8_t*>(other.data())[1023], 42);
+      EXPECT_NE(other.data(), segment.data());
+
+      auto moved = std::move(other);
+      EXPECT_EQ(segment.ref_count(), 2);
+      EXPECT_EQ(moved.size(), 1024);
+    }
+    EXPECT_EQ(segment.ref_count(), 1);
+  }
+  // The last reference has been released: the segment no longer exists.
+  EXPECT_THROW(detail::SharedMemory::attach(name), std::system_error);
+  EXPECT_FALSE(detail::SharedMemory::unlink(name));
+}
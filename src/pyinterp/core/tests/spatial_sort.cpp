@@ -0,0 +1,87 @@
+// Copyright (c) 2020 CNES
+//
+// All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include "pyinterp/detail/spatial_sort.hpp"
+
+namespace detail = pyinterp::detail;
+
+TEST(spatial_sort, morton_key) {
+  // Interleaves the bits one by one
+  auto naive = [](uint32_t x, uint32_t y, uint32_t z, uint32_t dims,
+                  uint32_t bits) {
+    auto result = uint64_t(0);
+    for (uint32_t ix = 0; ix < bits; ++ix) {
+      result |= static_cast<uint64_t>((x >> ix) & 1U) << (ix * dims);
+      result |= static_cast<uint64_t>((y >> ix) & 1U) << (ix * dims + 1);
+      if (dims == 3) {
+        result |= static_cast<uint64_t>((z >> ix) & 1U) << (ix * dims + 2);
+      }
+    }
+    return result;
+  };
+
+  EXPECT_EQ(detail::morton_key(0, 0), 0);
+  EXPECT_EQ(detail::morton_key(1, 0), 1);
+  EXPECT_EQ(detail::morton_key(0, 1), 2);
+  EXPECT_EQ(detail::morton_key(3, 3), 15);
+  EXPECT_EQ(detail::morton_key(0, 0, 1), 4);
+
+  auto generator = std::mt19937(0);
+  auto distribution = std::uniform_int_distribution<uint32_t>();
+  for (auto ix = 0; ix < 1000; ++ix) {
+    auto x = distribution(generator);
+    auto y = distribution(generator);
+    auto z = distribution(generator);
+    EXPECT_EQ(detail::morton_key(x, y), naive(x, y, 0, 2, 32));
+    EXPECT_EQ(detail::morton_key(x, y, z),
+              naive(x & 0x1fffffU, y & 0x1fffffU, z & 0x1fffffU, 3, 21));
+  }
+}
+
+TEST(spatial_sort, axis_quantizer) {
+  auto axis = detail::Axis<double>(-180, 179, 360, 1e-6, true);
+  auto quantizer = detail::AxisQuantizer<double>(axis, 16);
+  EXPECT_EQ(quantizer(-180), 0);
+  EXPECT_EQ(quantizer(180), 0);
+  EXPECT_EQ(quantizer(std::nan("")), 0);
+  EXPECT_LT(quantizer(-10), quantizer(10));
+  EXPECT_LT(quantizer(10), quantizer(179.9));
+  EXPECT_LE(quantizer(179.9), 65535);
+
+  auto latitude = detail::Axis<double>(-90, 90, 181, 1e-6, false);
+  auto y_quantizer = detail::AxisQuantizer<double>(latitude, 16);
+  EXPECT_EQ(y_quantizer(-100), 0);
+  EXPECT_EQ(y_quantizer(90), 65535);
+  EXPECT_EQ(y_quantizer(100), 65535);
+  EXPECT_LT(y_quantizer(-1), y_quantizer(1));
+}
+
+TEST(spatial_sort, argsort) {
+  auto generator = std::mt19937(0);
+  for (auto size : {0, 1, 7, 1000, 100000}) {
+    for (auto mask : {uint64_t(0xff), uint64_t(0xffffffff),
+                      uint64_t(0xffff0000ffff0000),
+                      std::numeric_limits<uint64_t>::max()}) {
+      auto keys = std::vector<uint64_t>(size);
+      for (auto& item : keys) {
+        item = ((static_cast<uint64_t>(generator()) << 32U) | generator()) &
+               mask;
+      }
+
+      auto expected = std::vector<int64_t>(size);
+      std::iota(expected.begin(), expected.end(), 0);
+      std::stable_sort(
+          expected.begin(), expected.end(),
+          [&](int64_t lhs, int64_t rhs) { return keys[lhs] < keys[rhs]; });
+
+      for (auto num_threads : {1, 3, 0}) {
+        EXPECT_EQ(detail::argsort(keys, num_threads), expected);
+      }
+    }
+  }
+}
@@ -55,11 +55,16 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
                  max_iteration: Optional[int] = None,
                  epsilon: Optional[float] = 1e-4,
                  relaxation: Optional[float] = None,
-                 num_threads: Optional[int] = 0):
+                 num_threads: Optional[int] = 0,
+                 sweep: str = "red_black"):
     """
     Replaces all undefined values (NaN) in a grid using the Gauss-Seidel
     method by relaxation.
 
+    By default, the cells are relaxed in red-black order: the cells of one
+    colour are updated concurrently from the cells of the other colour, so
+    the result does not depend on the number of threads used.
+
     Args:
         mesh (pyinterp.grid.Grid2D, pyinterp.grid.Grid3D): Grid function on
             a uniform 2/3-dimensional grid to be filled.
@@ -94,18 +99,30 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        sweep (str, optional): Order in which the cells are relaxed.
+            Supported values are:
+
+                * ``red_black``: the cells of one colour of a checkerboard
+                  are relaxed concurrently;
+                * ``pipelined``: the cells are relaxed in lexicographic order,
+                  the threads processing bands of columns one after the
+                  other.
+
+            Defaults to ``red_black``.
 
     Return:
         tuple: a boolean indicating if the calculation has converged, i. e. if
         the value of the residues is lower than the ``epsilon`` limit set, and
         the the grid will have the all NaN filled with extrapolated values.
     """
-    if first_guess not in ['zero', 'zonal_average']:
-        raise ValueError(f"first_guess type {first_guess!r} is not defined")
+    first_guess = _first_guess(first_guess)
+    if sweep not in ['red_black', 'pipelined']:
+        raise ValueError(f"sweep {sweep!r} is not defined")
+    sweep = getattr(core.fill.Sweep,
+                    "".join(item.capitalize() for item in sweep.split("_")))
 
     ny = len(mesh.y)
     nx = len(mesh.x)
-    nz = len(mesh.z) if isinstance(mesh, grid.Grid3D) else 0
 
     if relaxation is None:
         if nx == ny:
@@ -117,26 +134,79 @@ def gauss_seidel(mesh: Union[grid.Grid2D, grid.Grid3D],
     if max_iteration is None:
         max_iteration = nx * ny
 
-    first_guess = getattr(
+    return _solve("gauss_seidel", mesh, epsilon, num_threads, first_guess,
+                  mesh.x.is_circle, max_iteration, epsilon, relaxation,
+                  sweep=sweep)
+
+
+def multigrid(mesh: Union[grid.Grid2D, grid.Grid3D],
+              first_guess: Optional[str] = "zonal_average",
+              max_iteration: Optional[int] = 100,
+              epsilon: Optional[float] = 1e-4,
+              num_threads: Optional[int] = 0):
+    """
+    Replaces all undefined values (NaN) in a grid by solving the same
+    Poisson's equation as :py:func:`gauss_seidel` with a geometric multigrid
+    method.
+
+    Each multigrid cycle relaxes the grid with Gauss-Seidel sweeps, then
+    corrects it with the solution of the residual equation computed on
+    coarser grids. The number of cycles required to converge does not depend
+    on the size of the grid or of its undefined areas: filling large gaps
+    takes a few cycles instead of the thousands of iterations needed by the
+    relaxation.
+
+    Args:
+        mesh (pyinterp.grid.Grid2D, pyinterp.grid.Grid3D): Grid function on
+            a uniform 2/3-dimensional grid to be filled.
+        first_guess (str, optional): Specifies the type of first guess grid.
+            Supported values are ``zero`` and ``zonal_average``. Defaults to
+            ``zonal_average``.
+        max_iteration (int, optional): Maximum number of multigrid cycles.
+            Defaults to ``100``.
+        epsilon (float, optional): Tolerance for ending the cycles before the
+            maximum number of iterations limit. Defaults to ``1e-4``.
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+
+    Return:
+        tuple: a boolean indicating if the calculation has converged, i. e. if
+        the value of the residues is lower than the ``epsilon`` limit set, and
+        the the grid will have the all NaN filled with extrapolated values.
+    """
+    return _solve("multigrid", mesh, epsilon, num_threads,
+                  _first_guess(first_guess), mesh.x.is_circle, max_iteration,
+                  epsilon)
+
+
+def _first_guess(first_guess: str) -> core.fill.FirstGuess:
+    """Gets the type of first guess grid from its name"""
+    if first_guess not in ['zero', 'zonal_average']:
+        raise ValueError(f"first_guess type {first_guess!r} is not defined")
+    return getattr(
         getattr(core.fill, "FirstGuess"),
         "".join(item.capitalize() for item in first_guess.split("_")))
 
+
+def _solve(name: str, mesh: Union[grid.Grid2D, grid.Grid3D], epsilon: float,
+           num_threads: int, *args, **kwargs):
+    """Solves Poisson's equation on a copy of the grid, layer by layer for
+    a 3D grid"""
     instance = mesh._instance
-    function = interface._core_function("gauss_seidel", instance)
+    function = getattr(core.fill, interface._core_function(name, instance))
     filled = np.copy(mesh.array)
-    if nz == 0:
-        _iterations, residual = getattr(core.fill,
-                                        function)(filled, first_guess,
-                                                  mesh.x.is_circle,
-                                                  max_iteration, epsilon,
-                                                  relaxation, num_threads)
+    if not isinstance(mesh, grid.Grid3D):
+        _iterations, residual = function(filled, *args, num_threads,
+                                         **kwargs)
     else:
         with concurrent.futures.ThreadPoolExecutor(
                 max_workers=num_threads if num_threads else None) as executor:
             futures = [
-                executor.submit(getattr(core.fill, function), filled[:, :, iz],
-                                first_guess, mesh.x.is_circle, max_iteration,
-                                epsilon, relaxation, 1) for iz in range(nz)
+                executor.submit(function, filled[:, :, iz], *args, 1,
+                                **kwargs)
+                for iz in range(len(mesh.z))
             ]
             residuals = []
             for future in concurrent.futures.as_completed(futures):
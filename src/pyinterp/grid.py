@@ -79,6 +79,9 @@ class Grid2D:
                     args[-1] = np.flip(args[-1], axis=idx)
         self._instance = getattr(core, _class)(*args)
         self._prefix = prefix
+        #: Coefficients of the B-spline interpolating the grid, computed on
+        #: demand
+        self._coefficients = None
 
     def __repr__(self):
         """Called by the ``repr()`` built-in function to compute the string
@@ -126,6 +129,29 @@ class Grid2D:
         """
         return self._instance.array
 
+    def spline_coefficients(self, num_threads: int = 0) -> object:
+        """
+        Gets the coefficients of the cubic B-spline interpolating the grid
+        along the X and Y axes, used by the ``b_spline`` fitting model of
+        :py:func:`pyinterp.bicubic`. The coefficients are computed on the
+        first call, then kept with the grid, and pickled with it.
+
+        Args:
+            num_threads (int, optional): The number of threads to use for
+                the computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Defaults to ``0``.
+        Return:
+            The core grid holding the coefficients, defined on the axes of
+            this grid.
+        """
+        if self._coefficients is None:
+            function = interface._core_function("spline_coefficients",
+                                                self._instance)
+            self._coefficients = getattr(core, function)(self._instance,
+                                                         num_threads)
+        return self._coefficients
+
 
 class Grid3D(Grid2D):
     """3D Cartesian Grid
@@ -177,6 +203,34 @@ class Grid3D(Grid2D):
         """
         return self._instance.z
 
+    def update_array(self, array: np.ndarray) -> None:
+        """
+        Replaces the values of the grid. The array is referenced, not copied,
+        and must not be modified afterwards. The interpolations in progress
+        end with the previous values, the following ones use the new values.
+
+        Args:
+            array (numpy.ndarray): New values of the grid, with the same
+                shape as the current values.
+        """
+        self._instance.update_array(array)
+        self._coefficients = None
+
+    def update_slice(self, index: int, values: np.ndarray) -> None:
+        """
+        Replaces the values of the grid for an index of the Z-Axis, for
+        example the latest time step of a forecast. The interpolations in
+        progress end with the previous values, the following ones use the
+        new values.
+
+        Args:
+            index (int): Index of the slice on the Z-Axis.
+            values (numpy.ndarray): Values of the slice, an array of the grid
+                shape without the Z dimension.
+        """
+        self._instance.update_slice(index, values)
+        self._coefficients = None
+
 
 class Grid4D(Grid3D):
     """4D Cartesian Grid
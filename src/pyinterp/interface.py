@@ -6,6 +6,7 @@
 Interface with the library core
 ===============================
 """
+from typing import Optional
 import numpy as np
 from . import core
 
@@ -61,3 +62,34 @@ def _core_function(function: str, instance: object) -> str:
     name = instance.__class__.__name__
     suffix = "float64" if name.endswith("Float64") else "float32"
     return f"{function}_{suffix}"
+
+
+def _core_function_dtype(function: str,
+                         instance: object,
+                         dtype: Optional[np.dtype],
+                         variant: str = "single") -> str:
+    """Get the name of the function handling the grid instance and returning
+    values of the type requested.
+
+    Args:
+        function (str): name of the function
+        instance (object): grid instance
+        dtype (numpy.dtype, optional): type of the values returned, float64
+            if not set. float32 selects the variant returning values in
+            single precision, available for the grids of float32 values.
+        variant (str, optional): name of this variant: ``single`` if it
+            calculates in single precision, ``narrow`` if it only converts
+            the values calculated in double precision.
+    Return:
+        str: the name of the function
+    """
+    name = _core_function(function, instance)
+    if dtype is None or np.dtype(dtype) == np.float64:
+        return name
+    if np.dtype(dtype) != np.float32:
+        raise ValueError(f"dtype {dtype!r} is not handled, use float64 or "
+                         "float32")
+    if not name.endswith("float32"):
+        raise ValueError("float32 values can only be returned for a grid of "
+                         "float32 values")
+    return f"{function}_{variant}_float32"
@@ -1,4 +1,6 @@
-from .bicubic import bicubic
-from .bivariate import bivariate
+from .bicubic import bicubic, bicubic_gradient
+from .bivariate import bivariate, bilinear_gradient
+from .plan import BivariatePlan, TrivariatePlan
+from .stream import TrivariateStream
 from .trivariate import trivariate
 from .quadrivariate import quadrivariate
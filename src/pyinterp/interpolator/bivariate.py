@@ -6,6 +6,7 @@
 Bivariate interpolation
 =======================
 """
+from typing import Optional, Tuple
 import numpy as np
 from .. import core
 from .. import grid
@@ -18,6 +19,9 @@ def bivariate(grid2d: grid.Grid2D,
               interpolator: str = "bilinear",
               bounds_error: bool = False,
               num_threads: int = 0,
+              spatial_sort: bool = False,
+              out: Optional[np.ndarray] = None,
+              dtype: Optional[np.dtype] = None,
               **kwargs) -> np.ndarray:
     """Interpolate the values provided on the defined bivariate function.
 
@@ -37,14 +41,74 @@ def bivariate(grid2d: grid.Grid2D,
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        spatial_sort (bool, optional): If True, the points are interpolated
+            in the order of their position on the grid, which limits the
+            cache misses when the points are provided in a random order.
+            The values are returned in the order of the points provided.
+            Sorting the points pays off from about 100,000 points. Defaults
+            to ``False``.
+        out (numpy.ndarray, optional): Array receiving the values
+            interpolated, instead of a new array: a writable, C-contiguous,
+            array of the type and shape of the result. It must not overlap
+            the coordinates.
+        dtype (numpy.dtype, optional): Type of the values returned,
+            ``float64`` or ``float32``. ``float32`` is available for the
+            grids of float32 values: the coordinates are converted to
+            float32, and the values are interpolated in single precision.
+            Defaults to ``float64``.
         p (int, optional): The power to be used by the interpolator
             inverse_distance_weighting. Default to ``2``.
+        distance (pyinterp.core.Distance, optional): The method used by the
+            interpolators nearest and inverse_distance_weighting to calculate
+            the distances: ``Distance.Equirectangular`` is faster than the
+            default ``Distance.Haversine``, for a relative error of about
+            4e-5 for cells of one degree.
     Return:
-        numpy.ndarray: Values interpolated
+        numpy.ndarray: Values interpolated, an array of the shape of the
+        coordinates.
     """
     instance = grid2d._instance
-    function = interface._core_function("bivariate", instance)
+    function = interface._core_function_dtype("bivariate", instance, dtype)
     return getattr(core, function)(instance, np.asarray(x), np.asarray(y),
                                    grid._core_variate_interpolator(
                                        grid2d, interpolator, **kwargs),
-                                   bounds_error, num_threads)
+                                   bounds_error, num_threads, spatial_sort,
+                                   out)
+
+
+def bilinear_gradient(grid2d: grid.Grid2D,
+                      x: np.ndarray,
+                      y: np.ndarray,
+                      mixed: bool = False,
+                      bounds_error: bool = False,
+                      num_threads: int = 0) -> Tuple[np.ndarray, ...]:
+    """Bilinear interpolation of a 2D grid, and calculation of the partial
+    derivatives of the interpolated surface. The cell containing each point
+    is searched only once for the value and its derivatives.
+
+    Args:
+        grid2d (pyinterp.grid.Grid2D): Function on a uniform 2-dimensional
+            grid to be interpolated.
+        x (numpy.ndarray): X-values
+        y (numpy.ndarray): Y-values
+        mixed (bool, optional): If True, the mixed derivative d²f/dxdy is
+            also calculated. Defaults to ``False``.
+        bounds_error (bool, optional): If True, when interpolated values
+            are requested outside of the domain of the input axes (x,y), a
+            :py:class:`ValueError` is raised. If False, then value is set
+            to NaN. Default to ``False``
+        num_threads (int, optional): The number of threads to use for the
+            computation. If 0 all CPUs are used. If 1 is given, no parallel
+            computing code is used at all, which is useful for debugging.
+            Defaults to ``0``.
+    Return:
+        tuple: The values interpolated, df/dx, df/dy, and d²f/dxdy if
+        requested, arrays of the shape of the coordinates. The derivatives
+        are expressed per unit of the axes.
+    """
+    if grid2d._DIMENSIONS != 2:
+        raise TypeError("grid2d must be a pyinterp.grid.Grid2D")
+    instance = grid2d._instance
+    function = interface._core_function("bilinear_gradient", instance)
+    return getattr(core, function)(instance, np.asarray(x), np.asarray(y),
+                                   mixed, bounds_error, num_threads)
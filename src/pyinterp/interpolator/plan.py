@@ -0,0 +1,174 @@
+# Copyright (c) 2020 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Interpolation plans
+===================
+"""
+from typing import Optional
+import numpy as np
+from .. import core
+from .. import grid
+
+
+class BivariatePlan:
+    """Interpolation of several 2D grids, sharing the same axes, at a fixed
+    set of points.
+
+    The axes are searched and the weights of the interpolator are computed
+    once, when the plan is created: interpolating a grid then only gathers
+    the values of the cells containing the points and computes their
+    weighted sum.
+    """
+    def __init__(self,
+                 grid2d: grid.Grid2D,
+                 x: np.ndarray,
+                 y: np.ndarray,
+                 interpolator: str = "bilinear",
+                 bounds_error: bool = False,
+                 num_threads: int = 0,
+                 **kwargs):
+        """Creates the plan interpolating the points provided.
+
+        Args:
+            grid2d (pyinterp.grid.Grid2D): Grid defining the axes of the
+                grids to be interpolated.
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            interpolator (str, optional): The method of interpolation to
+                perform. Supported are ``bilinear``, ``nearest``, and
+                ``inverse_distance_weighting``. Default to ``bilinear``.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes (x,y),
+                a :py:class:`ValueError` is raised. If False, then value is
+                set to NaN. Default to ``False``
+            num_threads (int, optional): The number of threads to use for
+                the computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Defaults to ``0``.
+            p (int, optional): The power to be used by the interpolator
+                inverse_distance_weighting. Default to ``2``.
+            distance (pyinterp.core.Distance, optional): The method used by
+                the interpolators nearest and inverse_distance_weighting to
+                calculate the distances: ``Distance.Equirectangular`` is
+                faster than the default ``Distance.Haversine``, for a
+                relative error of about 4e-5 for cells of one degree.
+        """
+        self._instance = core.BivariatePlan(
+            grid2d.x, grid2d.y, np.asarray(x), np.asarray(y),
+            grid._core_variate_interpolator(grid2d, interpolator, **kwargs),
+            bounds_error, num_threads)
+
+    def __len__(self) -> int:
+        return len(self._instance)
+
+    def apply(self,
+              grid2d: grid.Grid2D,
+              num_threads: int = 0,
+              out: Optional[np.ndarray] = None) -> np.ndarray:
+        """Interpolates the grid at the points of the plan.
+
+        Args:
+            grid2d (pyinterp.grid.Grid2D): Grid to be interpolated. Its axes
+                must be equal to the axes used to create the plan.
+            num_threads (int, optional): The number of threads to use for
+                the computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Defaults to ``0``.
+            out (numpy.ndarray, optional): Array receiving the values
+                interpolated, instead of a new array: a writable,
+                C-contiguous, array of the type and shape of the result.
+        Return:
+            numpy.ndarray: Values interpolated, an array of the shape of
+            the coordinates of the points.
+        """
+        return self._instance.apply(grid2d._instance, num_threads, out)
+
+
+class TrivariatePlan:
+    """Interpolation of several 3D grids, sharing the same axes, at a fixed
+    set of points.
+
+    The axes are searched and the weights of the interpolator are computed
+    once, when the plan is created: interpolating a grid then only gathers
+    the values of the cells containing the points and computes their
+    weighted sum.
+    """
+    def __init__(self,
+                 grid3d: grid.Grid3D,
+                 x: np.ndarray,
+                 y: np.ndarray,
+                 z: np.ndarray,
+                 interpolator: str = "bilinear",
+                 z_method: str = "linear",
+                 bounds_error: bool = False,
+                 num_threads: int = 0,
+                 **kwargs):
+        """Creates the plan interpolating the points provided.
+
+        Args:
+            grid3d (pyinterp.grid.Grid3D): Grid defining the axes of the
+                grids to be interpolated.
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            z (numpy.ndarray): Z-values
+            interpolator (str, optional): The interpolation method to be
+                performed on the surface defined by the Y and Y axes.
+                Supported are ``bilinear`` and ``nearest``, and
+                ``inverse_distance_weighting``. Default to ``bilinear``.
+            z_method (str, optional): The interpolation method to be
+                performed on the Z axis. Supported are ``linear``and
+                ``nearest``. Default to ``linear``.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the input axes
+                (x,y,z), a :py:class:`ValueError` is raised. If False, then
+                value is set to NaN. Default to ``False``
+            num_threads (int, optional): The number of threads to use for
+                the computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Defaults to ``0``.
+            p (int, optional): The power to be used by the interpolator
+                inverse_distance_weighting. Default to ``2``.
+            distance (pyinterp.core.Distance, optional): The method used by
+                the interpolators nearest and inverse_distance_weighting to
+                calculate the distances: ``Distance.Equirectangular`` is
+                faster than the default ``Distance.Haversine``, for a
+                relative error of about 4e-5 for cells of one degree.
+        """
+        self._instance = getattr(core, f"{grid3d._prefix}TrivariatePlan")(
+            grid3d.x,
+            grid3d.y,
+            grid3d.z,
+            np.asarray(x),
+            np.asarray(y),
+            np.asarray(z),
+            grid._core_variate_interpolator(grid3d, interpolator, **kwargs),
+            z_method=z_method,
+            bounds_error=bounds_error,
+            num_threads=num_threads)
+
+    def __len__(self) -> int:
+        return len(self._instance)
+
+    def apply(self,
+              grid3d: grid.Grid3D,
+              num_threads: int = 0,
+              out: Optional[np.ndarray] = None) -> np.ndarray:
+        """Interpolates the grid at the points of the plan.
+
+        Args:
+            grid3d (pyinterp.grid.Grid3D): Grid to be interpolated. Its axes
+                must be equal to the axes used to create the plan.
+            num_threads (int, optional): The number of threads to use for
+                the computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Defaults to ``0``.
+            out (numpy.ndarray, optional): Array receiving the values
+                interpolated, instead of a new array: a writable,
+                C-contiguous, array of the type and shape of the result.
+        Return:
+            numpy.ndarray: Values interpolated, an array of the shape of
+            the coordinates of the points.
+        """
+        return self._instance.apply(grid3d._instance, num_threads, out)
@@ -6,6 +6,7 @@
 Quadrivariate interpolation
 ===========================
 """
+from typing import Optional
 import numpy as np
 from .. import core
 from .. import grid
@@ -22,6 +23,8 @@ def quadrivariate(grid4d: grid.Grid4D,
                   u_method: str = "linear",
                   bounds_error: bool = False,
                   num_threads: int = 0,
+                  out: Optional[np.ndarray] = None,
+                  dtype: Optional[np.dtype] = None,
                   **kwargs) -> np.ndarray:
     """Interpolate the values provided on the defined quadrivariate function.
 
@@ -50,13 +53,29 @@ def quadrivariate(grid4d: grid.Grid4D,
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        out (numpy.ndarray, optional): Array receiving the values
+            interpolated, instead of a new array: a writable, C-contiguous,
+            array of the type and shape of the result. It must not overlap
+            the coordinates.
+        dtype (numpy.dtype, optional): Type of the values returned,
+            ``float64`` or ``float32``. ``float32`` is available for the
+            grids of float32 values: the X, Y and U coordinates are
+            converted to float32, and the values are interpolated in single
+            precision. Defaults to ``float64``.
         p (int, optional): The power to be used by the interpolator
             inverse_distance_weighting. Default to ``2``.
+        distance (pyinterp.core.Distance, optional): The method used by the
+            interpolators nearest and inverse_distance_weighting to calculate
+            the distances: ``Distance.Equirectangular`` is faster than the
+            default ``Distance.Haversine``, for a relative error of about
+            4e-5 for cells of one degree.
     Return:
-        numpy.ndarray: Values interpolated
+        numpy.ndarray: Values interpolated, an array of the shape of the
+        coordinates.
     """
     instance = grid4d._instance
-    function = interface._core_function("quadrivariate", instance)
+    function = interface._core_function_dtype("quadrivariate", instance,
+                                              dtype)
     return getattr(core, function)(instance,
                                    np.asarray(x),
                                    np.asarray(y),
@@ -67,4 +86,5 @@ def quadrivariate(grid4d: grid.Grid4D,
                                    z_method=z_method,
                                    u_method=u_method,
                                    bounds_error=bounds_error,
-                                   num_threads=num_threads)
+                                   num_threads=num_threads,
+                                   out=out)
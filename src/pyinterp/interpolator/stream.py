@@ -0,0 +1,214 @@
+# Copyright (c) 2020 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Streaming interpolation
+=======================
+"""
+from typing import Any, Iterable, Tuple
+import numpy as np
+from .. import core
+from .. import grid
+from ..axis import TemporalAxis
+from .trivariate import trivariate
+
+
+class TrivariateStream:
+    """Interpolation of a time series of 2D fields, too long to be held in
+    memory, at points provided in chronological order.
+
+    The fields are read one after the other, as the dates of the points
+    interpolated advance, and only the two fields framing these dates are
+    kept in memory: the memory used does not depend on the length of the
+    series.
+
+    Examples:
+
+        >>> import numpy as np
+        >>> import pyinterp
+        >>> x_axis = pyinterp.Axis(np.arange(-180.0, 180.0, 1.0),
+        ...                        is_circle=True)
+        >>> y_axis = pyinterp.Axis(np.arange(-80.0, 80.0, 1.0))
+        >>> dates = np.arange(np.datetime64("2000-01-01T00:00:00"),
+        ...                   np.datetime64("2001-01-01T00:00:00"),
+        ...                   np.timedelta64(1, "h"))
+        >>> fields = ((date, np.random.random((len(x_axis), len(y_axis))))
+        ...           for date in dates)
+        >>> stream = pyinterp.TrivariateStream(x_axis, y_axis, fields)
+        >>> stream(np.array([0.5]), np.array([10.5]),
+        ...        np.array(["2000-01-01T00:30"], dtype="datetime64[s]"))
+    """
+    def __init__(self,
+                 x: core.Axis,
+                 y: core.Axis,
+                 fields: Iterable[Tuple[Any, np.ndarray]],
+                 interpolator: str = "bilinear",
+                 z_method: str = "linear",
+                 bounds_error: bool = False,
+                 num_threads: int = 0,
+                 **kwargs):
+        """Initialize the interpolation of the series of fields provided.
+
+        Args:
+            x (pyinterp.Axis): X-Axis of the fields
+            y (pyinterp.Axis): Y-Axis of the fields
+            fields (iterable): The pairs ``(date, array)`` defining the
+                fields of the series, in increasing order of date. The dates
+                are ``numpy.datetime64`` values or numbers, the arrays have
+                the shape ``(len(x), len(y))``. The fields are read only
+                when the interpolation reaches their date: a generator, or
+                a loader called for each field wrapped by ``iter(loader,
+                None)``, reads the series lazily.
+            interpolator (str, optional): The interpolation method to be
+                performed on the surface defined by the X and Y axes.
+                Supported are ``bilinear``, ``nearest``, and
+                ``inverse_distance_weighting``. Default to ``bilinear``.
+            z_method (str, optional): The interpolation method to be
+                performed between two fields. Supported are ``linear`` and
+                ``nearest``. Default to ``linear``.
+            bounds_error (bool, optional): If True, when interpolated values
+                are requested outside of the domain of the axes or of the
+                series, a :py:class:`ValueError` is raised. If False, then
+                value is set to NaN. Default to ``False``
+            num_threads (int, optional): The number of threads to use for
+                the computation. If 0 all CPUs are used. If 1 is given, no
+                parallel computing code is used at all, which is useful for
+                debugging. Defaults to ``0``.
+            **kwargs: The parameters of the interpolator, as for
+                :py:func:`pyinterp.trivariate`.
+        """
+        self._x = x
+        self._y = y
+        self._fields = iter(fields)
+        self._interpolator = interpolator
+        self._z_method = z_method
+        self._bounds_error = bounds_error
+        self._num_threads = num_threads
+        self._kwargs = kwargs
+        #: Dates and values of the fields framing the dates interpolated
+        self._window = []
+        #: Grid holding the fields of the window, built only when points are
+        #: interpolated on it
+        self._grid = None
+        #: Date of the first field of the series
+        self._first = None
+        #: Time axis defining the unit of the dates of the series, if they
+        #: are numpy.datetime64 values
+        self._time = None
+
+    def _cast(self, dates: np.ndarray) -> np.ndarray:
+        """Converts dates into the unit of the dates of the series."""
+        if self._time is not None:
+            return self._time.safe_cast(dates)
+        if np.issubdtype(dates.dtype, np.dtype("datetime64")):
+            raise TypeError("the dates of the series are not datetime64 "
+                            "values")
+        return dates.astype("float64")
+
+    def _next(self) -> bool:
+        """Reads the next field of the series, which replaces the oldest
+        field of the window.
+
+        Return:
+            bool: False if the series is exhausted.
+        """
+        item = next(self._fields, None)
+        if item is None:
+            return False
+        date, array = item
+        date = np.asarray(date).reshape(1)
+        if self._first is None and np.issubdtype(date.dtype,
+                                                 np.dtype("datetime64")):
+            self._time = TemporalAxis(date)
+        date = self._cast(date)[0]
+        if self._first is None:
+            self._first = date
+        if self._window and date <= self._window[-1][0]:
+            raise ValueError("the dates of the fields must be increasing")
+        self._window = self._window[-1:] + [(date, np.asarray(array))]
+        self._grid = None
+        return True
+
+    def _window_grid(self) -> grid.Grid3D:
+        """Returns the grid holding the two fields of the window.
+
+        The grid is built on the first call after the window has moved, so
+        that the fields read to skip a gap in the dates interpolated are not
+        copied.
+        """
+        if self._grid is None:
+            dates = np.array([item for item, _ in self._window])
+            self._grid = grid.Grid3D(
+                self._x, self._y,
+                TemporalAxis(dates.astype(self._time.dtype))
+                if self._time is not None else core.Axis(dates),
+                np.stack([item for _, item in self._window], axis=-1))
+        return self._grid
+
+    def __call__(self, x: np.ndarray, y: np.ndarray,
+                 dates: np.ndarray) -> np.ndarray:
+        """Interpolates the series at the points provided.
+
+        The dates of the points must be sorted in increasing order, and must
+        not precede the dates of the points interpolated by the previous
+        calls, except those located before the first field of the series.
+
+        Args:
+            x (numpy.ndarray): X-values
+            y (numpy.ndarray): Y-values
+            dates (numpy.ndarray): Dates of the points, in the type of the
+                dates of the fields. The ``numpy.datetime64`` values are
+                converted to the unit of the dates of the fields.
+        Return:
+            numpy.ndarray: Values interpolated, an array of the shape of the
+            coordinates.
+        """
+        shape = np.shape(x)
+        x = np.asarray(x, dtype="float64").ravel()
+        y = np.asarray(y, dtype="float64").ravel()
+        dates = np.asarray(dates).ravel()
+        if x.shape != y.shape or x.shape != dates.shape:
+            raise ValueError("x, y and dates must have the same shape")
+        while len(self._window) < 2 and self._next():
+            pass
+        result = np.full(x.shape, np.nan)
+        if len(self._window) < 2:
+            if self._bounds_error and x.size:
+                raise ValueError("the series contains less than two fields")
+            return result.reshape(shape)
+        dates = self._cast(dates)
+        if np.any(dates[1:] < dates[:-1]):
+            raise ValueError("the dates must be sorted in increasing order")
+
+        # The points located before the first field of the series are
+        # outside the domain.
+        start = np.searchsorted(dates, self._first, side="left")
+        outside = start > 0
+        if start < dates.size and dates[start] < self._window[0][0]:
+            raise ValueError("the dates precede the fields already released")
+
+        while start < dates.size:
+            while dates[start] > self._window[-1][0] and self._next():
+                pass
+            if dates[start] > self._window[-1][0]:
+                break
+            end = np.searchsorted(dates, self._window[-1][0], side="right")
+            trivariate(self._window_grid(),
+                       x[start:end],
+                       y[start:end],
+                       dates[start:end],
+                       interpolator=self._interpolator,
+                       z_method=self._z_method,
+                       bounds_error=self._bounds_error,
+                       num_threads=self._num_threads,
+                       out=result[start:end],
+                       **self._kwargs)
+            start = end
+
+        # The points located after the last field of the series are outside
+        # the domain.
+        outside |= start < dates.size
+        if self._bounds_error and outside:
+            raise ValueError("the dates are outside the series")
+        return result.reshape(shape)
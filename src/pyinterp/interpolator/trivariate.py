@@ -6,6 +6,7 @@
 Trivariate interpolation
 ========================
 """
+from typing import Optional
 import numpy as np
 from .. import core
 from .. import grid
@@ -20,6 +21,9 @@ def trivariate(grid3d: grid.Grid3D,
                z_method: str = "linear",
                bounds_error: bool = False,
                num_threads: int = 0,
+               spatial_sort: bool = False,
+               out: Optional[np.ndarray] = None,
+               dtype: Optional[np.dtype] = None,
                **kwargs) -> np.ndarray:
     """Interpolate the values provided on the defined trivariate function.
 
@@ -44,13 +48,34 @@ def trivariate(grid3d: grid.Grid3D,
             computation. If 0 all CPUs are used. If 1 is given, no parallel
             computing code is used at all, which is useful for debugging.
             Defaults to ``0``.
+        spatial_sort (bool, optional): If True, the points are interpolated
+            in the order of their position on the grid, which limits the
+            cache misses when the points are provided in a random order.
+            The values are returned in the order of the points provided.
+            Sorting the points pays off from about 100,000 points. Defaults
+            to ``False``.
+        out (numpy.ndarray, optional): Array receiving the values
+            interpolated, instead of a new array: a writable, C-contiguous,
+            array of the type and shape of the result. It must not overlap
+            the coordinates.
+        dtype (numpy.dtype, optional): Type of the values returned,
+            ``float64`` or ``float32``. ``float32`` is available for the
+            grids of float32 values: the X and Y coordinates are converted
+            to float32, and the values are interpolated in single precision.
+            Defaults to ``float64``.
         p (int, optional): The power to be used by the interpolator
             inverse_distance_weighting. Default to ``2``.
+        distance (pyinterp.core.Distance, optional): The method used by the
+            interpolators nearest and inverse_distance_weighting to calculate
+            the distances: ``Distance.Equirectangular`` is faster than the
+            default ``Distance.Haversine``, for a relative error of about
+            4e-5 for cells of one degree.
     Return:
-        numpy.ndarray: Values interpolated
+        numpy.ndarray: Values interpolated, an array of the shape of the
+        coordinates.
     """
     instance = grid3d._instance
-    function = interface._core_function("trivariate", instance)
+    function = interface._core_function_dtype("trivariate", instance, dtype)
     return getattr(core, function)(instance,
                                    np.asarray(x),
                                    np.asarray(y),
@@ -59,4 +84,6 @@ def trivariate(grid3d: grid.Grid3D,
                                        grid3d, interpolator, **kwargs),
                                    z_method=z_method,
                                    bounds_error=bounds_error,
-                                   num_threads=num_threads)
+                                   num_threads=num_threads,
+                                   spatial_sort=spatial_sort,
+                                   out=out)
@@ -105,7 +105,9 @@ class RTree:
               coordinates: np.ndarray,
               k: Optional[int] = 4,
               within: Optional[bool] = True,
-              num_threads: Optional[int] = 0) -> Tuple[np.ndarray, np.ndarray]:
+              num_threads: Optional[int] = 0,
+              out: Optional[Tuple[np.ndarray, np.ndarray]] = None
+              ) -> Tuple[np.ndarray, np.ndarray]:
         """Search for the nearest K nearest neighbors of a given point.
 
         Args:
@@ -125,13 +127,17 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            out (tuple, optional): Pair of arrays receiving the results,
+                instead of new arrays: writable, C-contiguous, arrays of the
+                type and shape of the results. They must not overlap the
+                coordinates.
         Return:
             tuple: A tuple containing a matrix describing for each provided
             position, the distance, in meters, between the provided position
             and the found neighbors and a matrix containing the value of the
             different neighbors found for all provided positions.
         """
-        return self._instance.query(coordinates, k, within, num_threads)
+        return self._instance.query(coordinates, k, within, num_threads, out)
 
     def inverse_distance_weighting(self,
                                    coordinates: np.ndarray,
@@ -139,7 +145,9 @@ class RTree:
                                    k: Optional[int] = 9,
                                    p: Optional[int] = 2,
                                    within: Optional[bool] = True,
-                                   num_threads: Optional[int] = 0
+                                   num_threads: Optional[int] = 0,
+                                   out: Optional[Tuple[np.ndarray,
+                                                       np.ndarray]] = None
                                    ) -> Tuple[np.ndarray, np.ndarray]:
         """Interpolation of the value at the requested position by inverse
         distance weighting method.
@@ -165,12 +173,16 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            out (tuple, optional): Pair of arrays receiving the results,
+                instead of new arrays: writable, C-contiguous, arrays of the
+                type and shape of the results. They must not overlap the
+                coordinates.
         Return:
             tuple: The interpolated value and the number of neighbors used in
             the calculation.
         """
         return self._instance.inverse_distance_weighting(
-            coordinates, radius, k, p, within, num_threads)
+            coordinates, radius, k, p, within, num_threads, out)
 
     def radial_basis_function(self,
                               coordinates: np.ndarray,
@@ -180,7 +192,9 @@ class RTree:
                               epsilon: Optional[float] = None,
                               smooth: Optional[float] = 0,
                               within: Optional[bool] = True,
-                              num_threads: Optional[int] = 0
+                              num_threads: Optional[int] = 0,
+                              out: Optional[Tuple[np.ndarray,
+                                                  np.ndarray]] = None
                               ) -> Tuple[np.ndarray, np.ndarray]:
         """Interpolation of the value at the requested position by radial
         basis function interpolation.
@@ -225,6 +239,10 @@ class RTree:
                 computation. If 0 all CPUs are used. If 1 is given, no parallel
                 computing code is used at all, which is useful for debugging.
                 Defaults to ``0``.
+            out (tuple, optional): Pair of arrays receiving the results,
+                instead of new arrays: writable, C-contiguous, arrays of the
+                type and shape of the results. They must not overlap the
+                coordinates.
         Return:
             tuple: The interpolated value and the number of neighbors used in
             the calculation.
@@ -241,7 +259,7 @@ class RTree:
 
         return self._instance.radial_basis_function(
             coordinates, radius, k, getattr(core.RadialBasisFunction, rbf),
-            epsilon, smooth, within, num_threads)
+            epsilon, smooth, within, num_threads, out)
 
     def __getstate__(self) -> Tuple:
         return (self.dtype, self._instance.__getstate__())
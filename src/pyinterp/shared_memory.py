@@ -0,0 +1,97 @@
+# Copyright (c) 2020 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+"""
+Grids hosted in shared memory
+=============================
+
+Publishes the axes and values of a grid in a named shared memory segment, so
+that other processes of the same host can access the grid without copying or
+unpickling it.
+"""
+from typing import Any
+import pickle
+import struct
+import numpy as np
+from . import core
+from . import grid
+
+#: Axes handled by the grids, in the order expected by their constructors.
+_AXES = ("x", "y", "z", "u")
+
+#: Alignment, in bytes, of the grid values in the segment.
+_ALIGNMENT = 64
+
+#: Format of the integer storing the length of the grid description.
+_LENGTH = struct.Struct("<Q")
+
+
+def _align(offset: int) -> int:
+    """Aligns an offset on the boundary used by the segments"""
+    return (offset + _ALIGNMENT - 1) // _ALIGNMENT * _ALIGNMENT
+
+
+def publish(instance: Any, name: str) -> core.SharedMemory:
+    """Publishes a grid in a new shared memory segment.
+
+    The segment holds a copy of the grid values, aligned on a cache line, and
+    the definition of its axes. It is destroyed when the last object
+    referencing it, in all processes, is released: the segment returned must
+    therefore be kept alive as long as the grid must remain available to the
+    other processes.
+
+    Args:
+        instance (pyinterp.Grid2D, pyinterp.Grid3D, pyinterp.Grid4D or a core
+            grid): Grid to publish.
+        name (str): Name of the segment, for example ``/my_grid``.
+    Return:
+        pyinterp.core.SharedMemory: The segment created.
+    """
+    wrapped = isinstance(instance, grid.Grid2D)
+    core_instance = instance._instance if wrapped else instance
+    axes = tuple(
+        getattr(core_instance, item) for item in _AXES
+        if hasattr(core_instance, item))
+    array = np.ascontiguousarray(core_instance.array)
+    description = pickle.dumps(
+        (type(instance).__name__, wrapped, axes, array.dtype.str,
+         array.shape))
+    offset = _align(_LENGTH.size + len(description))
+
+    segment = core.SharedMemory.create(name, offset + array.nbytes)
+    buffer = memoryview(segment).cast("B")
+    _LENGTH.pack_into(buffer, 0, len(description))
+    buffer[_LENGTH.size:_LENGTH.size + len(description)] = description
+    np.frombuffer(buffer, dtype=array.dtype, count=array.size,
+                  offset=offset).reshape(array.shape)[...] = array
+    return segment
+
+
+def attach(name: str) -> Any:
+    """Attaches a grid published in a shared memory segment.
+
+    The values of the grid returned are read-only and are not copied: they
+    reference the shared memory segment, which remains attached as long as
+    the grid exists.
+
+    Args:
+        name (str): Name of the segment.
+    Return:
+        The grid, of the type published.
+    """
+    segment = core.SharedMemory.attach(name)
+    buffer = memoryview(segment).cast("B")
+    length, = _LENGTH.unpack_from(buffer, 0)
+    class_name, wrapped, axes, dtype, shape = pickle.loads(
+        buffer[_LENGTH.size:_LENGTH.size + length])
+    offset = _align(_LENGTH.size + length)
+
+    array = np.frombuffer(buffer,
+                          dtype=np.dtype(dtype),
+                          count=int(np.prod(shape)),
+                          offset=offset).reshape(shape)
+    array.flags.writeable = False
+    if wrapped:
+        return getattr(grid, class_name)(*axes, array)
+    return getattr(core, class_name)(*axes, array)
@@ -116,6 +116,275 @@ class TestBivariate(TestCase):
         self.assertTrue((a - c).std() != 0)
         self.assertTrue((b - c).std() != 0)
 
+    def test_bivariate_spatial_sort(self):
+        """The points sorted on the grid give the same results"""
+        grid = self.load_data()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 100000)
+        y = generator.uniform(-90, 90, 100000)
+
+        for interpolator in [
+                core.Nearest2D(),
+                core.Bilinear2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            z0 = core.bivariate_float64(grid, x, y, interpolator)
+            z1 = core.bivariate_float64(grid,
+                                        x,
+                                        y,
+                                        interpolator,
+                                        spatial_sort=True)
+            self.assertTrue(
+                np.all(np.ma.fix_invalid(z0) == np.ma.fix_invalid(z1)))
+
+        z0 = core.bicubic_float64(grid, x, y)
+        z1 = core.bicubic_float64(grid, x, y, spatial_sort=True)
+        self.assertTrue(np.all(np.ma.fix_invalid(z0) == np.ma.fix_invalid(z1)))
+
+        with self.assertRaises(ValueError):
+            core.bivariate_float64(grid,
+                                   np.append(x, 0),
+                                   np.append(y, 100),
+                                   core.Bilinear2D(),
+                                   bounds_error=True,
+                                   spatial_sort=True)
+
+    def test_bivariate_ndarray(self):
+        """The coordinates can be N-D arrays of any strides"""
+        grid = self.load_data()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, (200, 100)).T
+        y = generator.uniform(-90, 90, (200, 100)).T
+        self.assertFalse(x.flags.c_contiguous)
+
+        for spatial_sort in [False, True]:
+            expected = core.bivariate_float64(grid, x.ravel(), y.ravel(),
+                                              core.Bilinear2D())
+            z = core.bivariate_float64(grid,
+                                       x,
+                                       y,
+                                       core.Bilinear2D(),
+                                       spatial_sort=spatial_sort)
+            self.assertEqual(z.shape, x.shape)
+            self.assertTrue(
+                np.all(
+                    np.ma.fix_invalid(z.ravel()) == np.ma.fix_invalid(
+                        expected)))
+
+        z = core.bicubic_float64(grid, x[::2, ::3], y[::2, ::3])
+        self.assertEqual(z.shape, x[::2, ::3].shape)
+
+        with self.assertRaises(ValueError):
+            core.bivariate_float64(grid, x, y.T, core.Bilinear2D())
+
+    def test_bivariate_out(self):
+        """The values are written into the array provided by the caller"""
+        grid = self.load_data()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 1000)
+        y = generator.uniform(-90, 90, 1000)
+        expected = core.bivariate_float64(grid, x, y, core.Bilinear2D())
+
+        for spatial_sort in [False, True]:
+            out = np.empty_like(x)
+            z = core.bivariate_float64(grid,
+                                       x,
+                                       y,
+                                       core.Bilinear2D(),
+                                       spatial_sort=spatial_sort,
+                                       out=out)
+            self.assertTrue(np.shares_memory(z, out))
+            self.assertTrue(
+                np.all(np.ma.fix_invalid(out) == np.ma.fix_invalid(expected)))
+
+        out = np.empty_like(x)
+        z = core.bicubic_float64(grid, x, y, out=out)
+        self.assertTrue(np.shares_memory(z, out))
+
+        readonly = np.empty_like(x)
+        readonly.flags.writeable = False
+        for out in [
+                np.empty(x.shape, dtype="float32"),
+                np.empty(x.size + 1),
+                np.empty((x.size, 1)),
+                np.empty(x.size * 2)[::2], readonly
+        ]:
+            with self.assertRaises(ValueError):
+                core.bivariate_float64(grid,
+                                       x,
+                                       y,
+                                       core.Bilinear2D(),
+                                       out=out)
+
+        with self.assertRaisesRegex(
+                ValueError, r"out has shape \(%d, 1\), expected shape "
+                r"\(%d,\)" % (x.size, x.size)):
+            core.bivariate_float64(grid,
+                                   x,
+                                   y,
+                                   core.Bilinear2D(),
+                                   out=np.empty((x.size, 1)))
+
+    def test_bivariate_float32(self):
+        """Interpolation in single precision"""
+        grid = self.load_data()
+        grid = core.Grid2DFloat32(grid.x, grid.y, grid.array.astype("float32"))
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 1000).astype("float32")
+        y = generator.uniform(-90, 90, 1000).astype("float32")
+
+        for interpolator in [
+                core.Bilinear2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            # The float32 coordinates are interpolated in double precision,
+            # unless single precision is requested
+            expected = core.bivariate_float32(grid, x, y, interpolator)
+            self.assertEqual(expected.dtype, np.float64)
+            z = core.bivariate_single_float32(grid, x, y, interpolator)
+            self.assertEqual(z.dtype, np.float32)
+            self.assertTrue(
+                np.allclose(z, expected, rtol=1e-4, atol=1e-3,
+                            equal_nan=True))
+
+        out = np.empty_like(x)
+        z = core.bivariate_single_float32(grid,
+                                          x,
+                                          y,
+                                          core.Bilinear2D(),
+                                          out=out)
+        self.assertTrue(np.shares_memory(z, out))
+
+    @staticmethod
+    def smooth_grid():
+        """Grid of a smooth function, with a step of one degree"""
+        x = np.arange(-180, 180, 1.0)
+        y = np.arange(-90, 91, 1.0)
+        mx, my = np.meshgrid(np.radians(x), np.radians(y), indexing="ij")
+        return core.Grid2DFloat64(core.Axis(x, is_circle=True), core.Axis(y),
+                                  np.sin(3 * mx) * np.cos(2 * my))
+
+    def test_bilinear_gradient(self):
+        """Values and derivatives of the bilinear interpolation"""
+        grid = self.smooth_grid()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 1000)
+        y = generator.uniform(-89, 89, 1000)
+        interpolator = core.Bilinear2D()
+
+        z, dx, dy, dxdy = core.bilinear_gradient_float64(grid,
+                                                         x,
+                                                         y,
+                                                         mixed=True)
+        expected = core.bivariate_float64(grid, x, y, interpolator)
+        self.assertTrue(np.allclose(z, expected, rtol=0))
+        self.assertEqual(dxdy.shape, x.shape)
+
+        # The points close to an edge of a cell are left out, the finite
+        # differences being calculated in two different cells.
+        h = 1e-6
+        inside = (np.abs(x % 1 - 0.5) < 0.49) & (np.abs(y % 1 - 0.5) < 0.49)
+        fx = (core.bivariate_float64(grid, x + h, y, interpolator) -
+              core.bivariate_float64(grid, x - h, y, interpolator)) / (2 * h)
+        fy = (core.bivariate_float64(grid, x, y + h, interpolator) -
+              core.bivariate_float64(grid, x, y - h, interpolator)) / (2 * h)
+        self.assertTrue(np.allclose(dx[inside], fx[inside], atol=1e-6))
+        self.assertTrue(np.allclose(dy[inside], fy[inside], atol=1e-6))
+
+        self.assertEqual(len(core.bilinear_gradient_float64(grid, x, y)), 3)
+
+    def test_bivariate_distance(self):
+        """Equirectangular approximation of the distances"""
+        grid = self.smooth_grid()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 10000)
+        y = generator.uniform(-89, 89, 10000)
+
+        for name, kwargs in [("InverseDistanceWeighting2D", dict(p=3)),
+                             ("Nearest2D", dict())]:
+            interpolator = getattr(core, name)(
+                distance=core.Distance.Equirectangular, **kwargs)
+            z0 = core.bivariate_float64(grid, x, y,
+                                        getattr(core, name)(**kwargs))
+            z1 = core.bivariate_float64(grid, x, y, interpolator)
+            # The nearest point may differ for the points located halfway
+            # between two grid points.
+            self.assertGreater(np.mean(np.abs(z0 - z1) < 1e-4), 0.999)
+
+            other = pickle.loads(pickle.dumps(interpolator))
+            self.assertTrue(
+                np.all(core.bivariate_float64(grid, x, y, other) == z1))
+
+        # The interpolator calculating in single precision uses the same
+        # distance. The cells of ten degrees make the difference between both
+        # distances larger than the rounding errors.
+        lon = np.arange(-180, 180, 10.0)
+        lat = np.arange(-90, 91, 10.0)
+        mx, my = np.meshgrid(np.radians(lon), np.radians(lat), indexing="ij")
+        grid = core.Grid2DFloat32(core.Axis(lon, is_circle=True),
+                                  core.Axis(lat),
+                                  (np.sin(3 * mx) *
+                                   np.cos(2 * my)).astype("float32"))
+        x = x.astype("float32")
+        y = y.astype("float32")
+        interpolator = core.InverseDistanceWeighting2D(
+            distance=core.Distance.Equirectangular)
+        z0 = core.bivariate_float32(grid, x, y,
+                                    core.InverseDistanceWeighting2D())
+        z1 = core.bivariate_float32(grid, x, y, interpolator)
+        z2 = core.bivariate_single_float32(grid, x, y, interpolator)
+        self.assertGreater(np.abs(z0 - z1).max(), 1e-4)
+        self.assertLess(np.abs(z2 - z1).max(), 1e-5)
+
+    def test_bivariate_batch(self):
+        """Interpolator written in Python, evaluating batches of points"""
+        class Interpolator(core.BivariateInterpolator2D):
+            def __init__(self):
+                super().__init__()
+                self.calls = 0
+
+            def evaluate(self, *args):
+                raise RuntimeError("evaluate must not be called")
+
+            def evaluate_batch(self, p, p0, p1, q):
+                self.calls += 1
+                t = (p[:, 0] - p0[:, 0]) / (p1[:, 0] - p0[:, 0])
+                u = (p[:, 1] - p0[:, 1]) / (p1[:, 1] - p0[:, 1])
+                return ((1 - t) * (1 - u) * q[:, 0] + (1 - t) * u * q[:, 1] +
+                        t * (1 - u) * q[:, 2] + t * u * q[:, 3])
+
+        grid = self.smooth_grid()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-360, 360, 100000)
+        y = generator.uniform(-95, 95, 100000)
+        expected = core.bivariate_float64(grid, x, y, core.Bilinear2D())
+
+        for spatial_sort in [False, True]:
+            interpolator = Interpolator()
+            z = core.bivariate_float64(grid,
+                                       x,
+                                       y,
+                                       interpolator,
+                                       spatial_sort=spatial_sort)
+            self.assertEqual(interpolator.calls, 2)
+            self.assertTrue(
+                np.allclose(z, expected, rtol=0, atol=1e-12,
+                            equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            core.bivariate_float64(grid,
+                                   x,
+                                   y,
+                                   Interpolator(),
+                                   bounds_error=True)
+
+        class Invalid(core.BivariateInterpolator2D):
+            def evaluate_batch(self, p, p0, p1, q):
+                return np.zeros(1)
+
+        with self.assertRaises(ValueError):
+            core.bivariate_float64(grid, x, y, Invalid())
+
     def test_bivariate_pickle(self):
         """Serialization of interpolator properties"""
         for item in [
@@ -127,6 +396,98 @@ class TestBivariate(TestCase):
             self.assertIsInstance(pickle.loads(pickle.dumps(obj)),
                                   getattr(core, item))
 
+    def test_bivariate_setstate(self):
+        """Restoration of the states written by the previous releases"""
+        for suffix in ['2D', '3D']:
+            cls = getattr(core, 'Nearest' + suffix)
+            obj = cls.__new__(cls)
+            obj.__setstate__(())
+            self.assertEqual(obj.__getstate__(), (core.Distance.Haversine, ))
+            with self.assertRaises(RuntimeError):
+                cls.__new__(cls).__setstate__(
+                    (core.Distance.Haversine, core.Distance.Haversine))
+
+            cls = getattr(core, 'InverseDistanceWeighting' + suffix)
+            obj = cls.__new__(cls)
+            obj.__setstate__((3, ))
+            self.assertEqual(obj.__getstate__(),
+                             (3, core.Distance.Haversine))
+            with self.assertRaises(RuntimeError):
+                cls.__new__(cls).__setstate__(())
+
+
+class TestMultiGrid2D(TestCase):
+    """Test of the C+++/Python interface of the pyinterp::MultiGrid2DFloat64
+    class"""
+    @classmethod
+    def load_multi_grid(cls):
+        grid = cls.load_data()
+        array = np.stack([grid.array, grid.array * 2, -grid.array], axis=-1)
+        return grid, core.MultiGrid2DFloat64(grid.x, grid.y, array)
+
+    def test_multi_grid2d_init(self):
+        """Test construction and accessors of the object"""
+        _, grid = self.load_multi_grid()
+        self.assertIsInstance(grid.x, core.Axis)
+        self.assertIsInstance(grid.y, core.Axis)
+        self.assertEqual(grid.variables, 3)
+        self.assertEqual(grid.array.shape[2], 3)
+        other = pickle.loads(pickle.dumps(grid))
+        self.assertEqual(grid.x, other.x)
+        self.assertEqual(grid.y, other.y)
+        self.assertEqual(other.variables, 3)
+        with self.assertRaises(ValueError):
+            core.MultiGrid2DFloat64(grid.x, grid.y, grid.array[:-1, :, :])
+
+    def test_multi_grid2d_interpolator(self):
+        """The interpolation of all variables at once must be identical to
+        the interpolation of each variable"""
+        grid, multi_grid = self.load_multi_grid()
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        x = x.flatten()
+        y = y.flatten()
+
+        for interpolator in [
+                core.Nearest2D(),
+                core.Bilinear2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            z = core.bivariate_float64(multi_grid, x, y, interpolator)
+            self.assertEqual(z.shape, (x.size, 3))
+            expected = core.bivariate_float64(grid, x, y, interpolator)
+            for ix, factor in enumerate([1, 2, -1]):
+                self.assertTrue(
+                    np.allclose(z[:, ix],
+                                expected * factor,
+                                equal_nan=True))
+
+        with self.assertRaises(ValueError):
+            core.bivariate_float64(multi_grid,
+                                   x,
+                                   y,
+                                   core.Bilinear2D(),
+                                   bounds_error=True)
+
+    def test_multi_grid2d_circle(self):
+        """Bilinear interpolation in the cell connecting the last and the
+        first longitudes"""
+        lon = np.arange(0, 360, 10.0)
+        lat = np.arange(-80, 81, 10.0)
+        mx, my = np.meshgrid(lon, lat, indexing="ij")
+        array = np.sin(np.radians(mx)) + my / 100
+        multi_grid = core.MultiGrid2DFloat64(
+            core.Axis(lon, is_circle=True), core.Axis(lat),
+            np.stack([array, array * 2], axis=-1))
+        x = np.array([351, 355, 359.5, -5, -0.5])
+        y = np.full_like(x, 5)
+        t = (x % 360 - 350) / 10
+        expected = (1 - t) * np.sin(np.radians(350)) + y / 100
+        z = core.bivariate_float64(multi_grid, x, y, core.Bilinear2D())
+        self.assertTrue(np.allclose(z[:, 0], expected))
+        self.assertTrue(np.allclose(z[:, 1], expected * 2))
+
 
 class TestBicubic(TestCase):
     """Test of the C+++/Python interface of the bicubic interpolator"""
@@ -167,6 +528,186 @@ class TestBicubic(TestCase):
                                  bounds_error=True,
                                  num_threads=0)
 
+    def test_bicubic_gradient(self):
+        """Values and derivatives of the bicubic interpolation"""
+        grid = TestBivariate.smooth_grid()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-170, 170, 1000)
+        y = generator.uniform(-80, 80, 1000)
+
+        z, dx, dy = core.bicubic_gradient_float64(grid, x, y)
+        expected = core.bicubic_float64(grid, x, y)
+        self.assertTrue(np.allclose(z, expected, rtol=0))
+
+        # The splines are fitted on windows that move with the point: the
+        # finite differences are wrong if a point changes window.
+        h = 1e-6
+        fx = (core.bicubic_float64(grid, x + h, y) -
+              core.bicubic_float64(grid, x - h, y)) / (2 * h)
+        fy = (core.bicubic_float64(grid, x, y + h) -
+              core.bicubic_float64(grid, x, y - h)) / (2 * h)
+        self.assertGreater(np.mean(np.isclose(dx, fx, rtol=0, atol=1e-6)),
+                           0.99)
+        self.assertGreater(np.mean(np.isclose(dy, fy, rtol=0, atol=1e-6)),
+                           0.99)
+
+        self.assertEqual(
+            len(core.bicubic_gradient_float64(grid, x, y, mixed=True)), 4)
+
+        with self.assertRaises(ValueError):
+            core.bicubic_gradient_float64(grid, x, y + 100, bounds_error=True)
+
+    def test_bicubic_cubic_convolution(self):
+        """Cubic convolution of regular grids"""
+        grid = TestBivariate.smooth_grid()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 1000)
+        y = generator.uniform(-88, 88, 1000)
+        model = core.FittingModel.CubicConvolution
+
+        z = core.bicubic_float64(grid, x, y, fitting_model=model)
+        expected = np.sin(3 * np.radians(x)) * np.cos(2 * np.radians(y))
+        self.assertTrue(np.allclose(z, expected, rtol=0, atol=1e-5))
+        self.assertTrue(
+            np.allclose(z,
+                        core.bicubic_float64(grid, x, y),
+                        rtol=0,
+                        atol=1e-4))
+        self.assertTrue(
+            np.all(z == core.bicubic_float64(
+                grid, x, y, fitting_model=model, num_threads=1)))
+
+        # The nodes of the window missing near the ends of the Y axis are
+        # defined by the boundary handling.
+        y = np.array([0.5, 89.5])
+        x = np.array([10.25, 10.25])
+        z = core.bicubic_float64(grid, x, y, fitting_model=model)
+        self.assertFalse(np.isnan(z[0]))
+        self.assertTrue(np.isnan(z[1]))
+        z = core.bicubic_float64(grid,
+                                 x,
+                                 y,
+                                 fitting_model=model,
+                                 boundary=core.AxisBoundary.Expand)
+        self.assertFalse(np.any(np.isnan(z)))
+        with self.assertRaises(ValueError):
+            core.bicubic_float64(grid,
+                                 x,
+                                 y,
+                                 fitting_model=model,
+                                 bounds_error=True)
+
+        # Only for the regular axes of 2D grids
+        with self.assertRaises(ValueError):
+            core.bicubic_gradient_float64(grid, x, y, fitting_model=model)
+        irregular = core.Grid2DFloat64(
+            grid.x, core.Axis(np.append(np.arange(-90, 90, 1.0), 90.5)),
+            grid.array)
+        with self.assertRaises(ValueError):
+            core.bicubic_float64(irregular, x, y, fitting_model=model)
+
+    def test_bicubic_b_spline(self):
+        """Cubic B-spline evaluated on the coefficients of the grid"""
+        grid = TestBivariate.smooth_grid()
+        coefficients = core.spline_coefficients_float64(grid, num_threads=1)
+        self.assertIsInstance(coefficients, core.Grid2DFloat64)
+        self.assertEqual(coefficients.x, grid.x)
+        self.assertEqual(coefficients.y, grid.y)
+        self.assertTrue(
+            np.all(coefficients.array == core.spline_coefficients_float64(
+                grid).array))
+        model = core.FittingModel.BSpline
+        boundary = core.AxisBoundary.Sym
+
+        # The spline interpolates the nodes, including those of the ends of
+        # the axes with the symmetrical boundary.
+        x, y = np.meshgrid(grid.x[:], grid.y[:], indexing="ij")
+        z = core.bicubic_float64(coefficients,
+                                 x.ravel(),
+                                 y.ravel(),
+                                 fitting_model=model,
+                                 boundary=boundary)
+        self.assertTrue(np.allclose(z, grid.array.ravel(), rtol=0,
+                                    atol=1e-12))
+
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 1000)
+        y = generator.uniform(-80, 80, 1000)
+        z = core.bicubic_float64(coefficients, x, y, fitting_model=model)
+        expected = np.sin(3 * np.radians(x)) * np.cos(2 * np.radians(y))
+        self.assertTrue(np.allclose(z, expected, rtol=0, atol=1e-6))
+
+        # The undefined values split the lines of the grid
+        array = grid.array.copy()
+        array[100, 50] = np.nan
+        other = core.spline_coefficients_float64(
+            core.Grid2DFloat64(grid.x, grid.y, array))
+        self.assertTrue(np.isnan(other.array[100, 50]))
+        self.assertEqual(np.isnan(other.array).sum(), 1)
+        z = core.bicubic_float64(other,
+                                 np.array([-79.5, 10.5]),
+                                 np.array([-39.5, 10.5]),
+                                 fitting_model=model)
+        self.assertTrue(np.isnan(z[0]))
+        self.assertAlmostEqual(z[1],
+                               np.sin(3 * np.radians(10.5)) *
+                               np.cos(2 * np.radians(10.5)),
+                               delta=1e-6)
+
+    def test_bicubic_cache(self):
+        """Bicubic interpolation of cells kept in a cache"""
+        grid = TestBivariate.smooth_grid()
+        # Repeated queries of 100 stations
+        generator = np.random.RandomState(0)
+        index = generator.randint(0, 100, 1000)
+        x = generator.uniform(-180, 180, 100)[index]
+        y = generator.uniform(-80, 80, 100)[index]
+
+        cache = core.BicubicCache(1000)
+        self.assertEqual(cache.capacity, 1000)
+        self.assertEqual(len(cache), 0)
+        for model in [core.FittingModel.CSpline, core.FittingModel.Linear]:
+            expected = core.bicubic_float64(grid, x, y, fitting_model=model)
+            for _ in range(2):
+                z = core.bicubic_float64(grid,
+                                         x,
+                                         y,
+                                         fitting_model=model,
+                                         num_threads=1,
+                                         cache=cache)
+                self.assertTrue(np.allclose(z, expected, rtol=0, atol=1e-12))
+        self.assertGreater(cache.hits, cache.misses)
+        self.assertEqual(len(cache), cache.misses)
+
+        # The cells of another grid are not shared
+        other = core.Grid2DFloat64(grid.x, grid.y, grid.array * 2)
+        z = core.bicubic_float64(other, x, y, num_threads=1, cache=cache)
+        self.assertTrue(
+            np.allclose(z, core.bicubic_float64(other, x, y), rtol=0,
+                        atol=1e-12))
+
+        cache.clear()
+        self.assertEqual(len(cache), 0)
+        self.assertEqual(cache.hits, 0)
+        self.assertEqual(cache.misses, 0)
+
+        # The cache keeps the most recently used cells
+        small = core.BicubicCache(4)
+        z = core.bicubic_float64(grid, x, y, cache=small)
+        self.assertEqual(len(small), 4)
+        self.assertTrue(
+            np.allclose(z, core.bicubic_float64(grid, x, y), rtol=0,
+                        atol=1e-12))
+
+        with self.assertRaises(ValueError):
+            core.bicubic_float64(grid,
+                                 x,
+                                 y,
+                                 fitting_model=core.FittingModel.Akima,
+                                 cache=cache)
+        with self.assertRaises(ValueError):
+            core.BicubicCache(0)
+
 
 if __name__ == "__main__":
     unittest.main()
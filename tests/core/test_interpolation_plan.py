@@ -0,0 +1,161 @@
+# Copyright (c) 2020 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import pickle
+import unittest
+import numpy as np
+import pyinterp.core as core
+
+
+def _values(*shape):
+    """Values of a grid containing some undefined values"""
+    generator = np.random.RandomState(0)
+    values = generator.uniform(-1, 1, shape)
+    values[generator.uniform(0, 1, shape) < 0.05] = np.nan
+    return values
+
+
+def _points(size):
+    generator = np.random.RandomState(1)
+    return (generator.uniform(-360, 360, size),
+            generator.uniform(-89.5, 89.5, size))
+
+
+class TestBivariatePlan(unittest.TestCase):
+    """Test of the C+++/Python interface of the pyinterp::BivariatePlan
+    class"""
+    @staticmethod
+    def grid():
+        return core.Grid2DFloat64(
+            core.Axis(np.arange(-180, 180, 0.5), is_circle=True),
+            core.Axis(np.arange(-89.5, 90, 0.5)), _values(720, 359))
+
+    def test_plan(self):
+        grid = self.grid()
+        x, y = _points(100000)
+
+        for interpolator in [
+                core.Bilinear2D(),
+                core.Nearest2D(),
+                core.InverseDistanceWeighting2D()
+        ]:
+            plan = core.BivariatePlan(grid.x, grid.y, x, y, interpolator)
+            self.assertEqual(len(plan), x.size)
+            expected = core.bivariate_float64(grid, x, y, interpolator)
+            z = plan.apply(grid)
+            self.assertTrue(
+                np.allclose(z, expected, rtol=0, atol=1e-9, equal_nan=True))
+
+            # The plan is reused for another grid sharing the same axes
+            other = core.Grid2DFloat32(grid.x, grid.y,
+                                       grid.array.astype("float32"))
+            self.assertTrue(
+                np.allclose(plan.apply(other, num_threads=1),
+                            core.bivariate_float32(other, x, y, interpolator),
+                            rtol=0,
+                            atol=1e-6,
+                            equal_nan=True))
+
+            other = pickle.loads(pickle.dumps(plan))
+            self.assertTrue(
+                np.allclose(other.apply(grid), z, rtol=0, equal_nan=True))
+
+            out = np.empty_like(z)
+            self.assertTrue(np.shares_memory(plan.apply(grid, out=out), out))
+            self.assertTrue(np.allclose(out, z, rtol=0, equal_nan=True))
+
+    def test_plan_ndarray(self):
+        grid = self.grid()
+        x, y = _points(10000)
+        x = x.reshape(100, 100).T
+        y = y.reshape(100, 100).T
+        interpolator = core.Bilinear2D()
+        plan = core.BivariatePlan(grid.x, grid.y, x, y, interpolator)
+        z = plan.apply(grid)
+        self.assertEqual(z.shape, x.shape)
+        self.assertTrue(
+            np.allclose(z,
+                        core.bivariate_float64(grid, x, y, interpolator),
+                        rtol=0,
+                        equal_nan=True))
+        self.assertEqual(pickle.loads(pickle.dumps(plan)).apply(grid).shape,
+                         x.shape)
+
+    def test_plan_errors(self):
+        grid = self.grid()
+        x, y = _points(1000)
+        interpolator = core.Bilinear2D()
+
+        with self.assertRaises(ValueError):
+            core.BivariatePlan(grid.x,
+                               grid.y,
+                               x,
+                               y + 10,
+                               interpolator,
+                               bounds_error=True)
+
+        plan = core.BivariatePlan(grid.x, grid.y, x, y, interpolator)
+        other = core.Grid2DFloat64(
+            grid.x, core.Axis(np.arange(-89, 90.5, 0.5)), grid.array)
+        with self.assertRaises(ValueError):
+            plan.apply(other)
+
+
+class TestTrivariatePlan(unittest.TestCase):
+    """Test of the C+++/Python interface of the pyinterp::TrivariatePlan
+    class"""
+    def test_plan(self):
+        x_axis = core.Axis(np.arange(-180, 180, 1.0), is_circle=True)
+        y_axis = core.Axis(np.arange(-90, 90.5, 1.0))
+        x, y = _points(100000)
+        z = np.random.RandomState(2).uniform(0, 9, x.size)
+
+        for temporal_axis in [False, True]:
+            prefix = "Temporal" if temporal_axis else ""
+            if temporal_axis:
+                z_axis = core.TemporalAxis(np.arange(10, dtype="int64") * 3600)
+                z_values = (z * 3600).astype("int64")
+                grid = core.TemporalGrid3DFloat64(x_axis, y_axis, z_axis,
+                                                  _values(360, 181, 10))
+            else:
+                z_axis = core.Axis(np.arange(10, dtype="float64"))
+                z_values = z
+                grid = core.Grid3DFloat64(x_axis, y_axis, z_axis,
+                                          _values(360, 181, 10))
+
+            for z_method in ["linear", "nearest"]:
+                interpolator = getattr(core, prefix + "Bilinear3D")()
+                plan = getattr(core, prefix + "TrivariatePlan")(
+                    grid.x,
+                    grid.y,
+                    grid.z,
+                    x,
+                    y,
+                    z_values,
+                    interpolator,
+                    z_method=z_method)
+                expected = core.trivariate_float64(grid,
+                                                   x,
+                                                   y,
+                                                   z_values,
+                                                   interpolator,
+                                                   z_method=z_method)
+                values = plan.apply(grid)
+                self.assertTrue(
+                    np.allclose(values,
+                                expected,
+                                rtol=0,
+                                atol=1e-9,
+                                equal_nan=True))
+
+                other = pickle.loads(pickle.dumps(plan))
+                self.assertTrue(
+                    np.allclose(other.apply(grid),
+                                values,
+                                rtol=0,
+                                equal_nan=True))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -133,6 +133,99 @@ class TestGrid4D(unittest.TestCase):
                                                u_method="NEAREST",
                                                bounds_error=False)
 
+    def test_circle(self):
+        """Bilinear interpolation in the cell connecting the last and the
+        first longitudes"""
+        lon = np.arange(0, 360, 10.0)
+        lat = np.arange(-80, 81, 10.0)
+        z = np.arange(3.0)
+        u = np.arange(2.0)
+        mx, my, mz, mu = np.meshgrid(lon, lat, z, u, indexing="ij")
+        grid = core.Grid4DFloat64(
+            core.Axis(lon, is_circle=True), core.Axis(lat), core.Axis(z),
+            core.Axis(u),
+            np.sin(np.radians(mx)) + my / 100 + mz + mu)
+        x = np.array([351, 355, 359.5, -5, -0.5])
+        y = np.full_like(x, 5)
+        z = np.full_like(x, 0.5)
+        u = np.full_like(x, 0.5)
+        t = (x % 360 - 350) / 10
+        expected = (1 - t) * np.sin(np.radians(350)) + y / 100 + z + u
+        self.assertTrue(
+            np.allclose(
+                core.quadrivariate_float64(grid, x, y, z, u,
+                                           core.Bilinear3D()), expected))
+
+    def test_bicubic_spline(self):
+        """Splines along the Z and U axes follow the curvature of the
+        function"""
+        axes = [
+            core.Axis(np.arange(0.0, 30.0)),
+            core.Axis(np.arange(0.0, 30.0)),
+            core.Axis(np.arange(0.0, 12.0)),
+            core.Axis(np.arange(0.0, 10.0))
+        ]
+        x, y, z, u = np.meshgrid(*(item[:] for item in axes), indexing="ij")
+
+        def function(x, y, z, u):
+            return np.sin(x * 0.1) * np.cos(y * 0.1) * np.sin(
+                z * 0.3) * np.cos(u * 0.4)
+
+        grid = core.Grid4DFloat64(*axes, function(x, y, z, u))
+
+        generator = np.random.RandomState(0)
+        x = generator.uniform(5, 24, 10000)
+        y = generator.uniform(5, 24, 10000)
+        z = generator.uniform(3, 8, 10000)
+        u = generator.uniform(3, 6, 10000)
+        expected = function(x, y, z, u)
+
+        z0 = core.bicubic_float64(grid, x, y, z, u, num_threads=1)
+        z1 = core.bicubic_float64(grid, x, y, z, u, num_threads=1, nz=2)
+        z2 = core.bicubic_float64(grid,
+                                  x,
+                                  y,
+                                  z,
+                                  u,
+                                  num_threads=1,
+                                  nz=2,
+                                  nu=2)
+        error = [np.abs(item - expected).max() for item in (z0, z1, z2)]
+        self.assertLess(error[1], error[0])
+        self.assertLess(error[2], error[1])
+
+    def test_nearest(self):
+        """The nearest method interpolates the nearest plane"""
+        grid = self.load_data()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-1, 0.8, 10000)
+        y = generator.uniform(-1, 0.8, 10000)
+        z = generator.uniform(-1, 0.8, 10000)
+        u = generator.uniform(-1, 9.8, 10000)
+        z_nearest = np.round(z / 0.2) * 0.2
+        u_nearest = np.round(u / 0.2) * 0.2
+
+        for interpolator in [
+                core.Bilinear3D(),
+                core.InverseDistanceWeighting3D()
+        ]:
+            for z_method, u_method, zi, ui in [
+                ("nearest", "linear", z_nearest, u),
+                ("linear", "nearest", z, u_nearest),
+                ("nearest", "nearest", z_nearest, u_nearest),
+            ]:
+                calculated = core.quadrivariate_float64(grid,
+                                                        x,
+                                                        y,
+                                                        z,
+                                                        u,
+                                                        interpolator,
+                                                        z_method=z_method,
+                                                        u_method=u_method)
+                expected = core.quadrivariate_float64(grid, x, y, zi, ui,
+                                                      interpolator)
+                self.assertTrue(np.allclose(calculated, expected))
+
 
 if __name__ == "__main__":
     unittest.main()
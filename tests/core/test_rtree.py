@@ -86,6 +86,22 @@ class TestRTree(unittest.TestCase):
         if HAVE_PLT:
             plot(x, y, z0.reshape((len(lon), len(lat))), "mss_rtree_idw.png")
 
+    def test_rtree_out(self):
+        """The results are written into the arrays provided by the caller"""
+        mesh = self.load_data()
+        coordinates = np.array([[0, 0], [45, 45], [-120, -60]],
+                               dtype="float32")
+        distance, value = mesh.query(coordinates, k=4)
+        out = (np.empty_like(distance), np.empty_like(value))
+        result = mesh.query(coordinates, k=4, out=out)
+        self.assertTrue(np.shares_memory(result[0], out[0]))
+        self.assertTrue(np.shares_memory(result[1], out[1]))
+        self.assertTrue(np.all(out[0] == distance))
+        self.assertTrue(np.all(out[1] == value))
+
+        with self.assertRaises(ValueError):
+            mesh.query(coordinates, k=3, out=out)
+
     def test_rtree_rbf(self):
         """Interpolation test"""
         mesh = self.load_data()
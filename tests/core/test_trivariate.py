@@ -4,6 +4,7 @@
 # BSD-style license that can be found in the LICENSE file.
 import os
 import pickle
+import threading
 import unittest
 import netCDF4
 try:
@@ -79,6 +80,152 @@ class TestGrid3D(TestCase):
                     other.array)))
 
 
+class TestGrid3DUpdate(unittest.TestCase):
+    """Test of the update of the values of the grid"""
+    @staticmethod
+    def grid():
+        x_axis = core.Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+        y_axis = core.Axis(np.arange(-80.0, 80.0, 1.0))
+        z_axis = core.Axis(np.arange(0.0, 4.0, 1.0))
+        array = np.zeros((len(x_axis), len(y_axis), len(z_axis)))
+        return core.Grid3DFloat64(x_axis, y_axis, z_axis, array)
+
+    def test_update_slice(self):
+        grid = self.grid()
+        shape = grid.array.shape
+        previous = grid.array
+        for index in [3, 3, 1, 3, 0]:
+            values = np.full(shape[:2], index + 1.0)
+            grid.update_slice(index, values)
+            self.assertTrue(np.all(grid.array[:, :, index] == index + 1))
+        # The array referenced before the updates is not modified.
+        self.assertTrue(np.all(previous == 0))
+        self.assertTrue(np.all(grid.array[:, :, 2] == 0))
+        self.assertTrue(np.all(grid.array[:, :, 3] == 4))
+        self.assertTrue(np.all(grid.array[:, :, 1] == 2))
+        self.assertTrue(np.all(grid.array[:, :, 0] == 1))
+
+        # An array referenced between two updates is not modified.
+        current = grid.array
+        grid.update_slice(2, np.full(shape[:2], 3.0))
+        grid.update_slice(1, np.full(shape[:2], -1.0))
+        self.assertTrue(np.all(current[:, :, 2] == 0))
+        self.assertTrue(np.all(current[:, :, 1] == 2))
+        self.assertTrue(np.all(grid.array[:, :, 2] == 3))
+        self.assertTrue(np.all(grid.array[:, :, 1] == -1))
+
+        x = np.array([0.5])
+        y = np.array([0.5])
+        z = np.array([1.5])
+        self.assertAlmostEqual(
+            core.trivariate_float64(grid, x, y, z, core.Bilinear3D())[0], 1)
+
+        with self.assertRaises(IndexError):
+            grid.update_slice(4, np.zeros(shape[:2]))
+        with self.assertRaises(ValueError):
+            grid.update_slice(0, np.zeros((2, 2)))
+
+    def test_update_array(self):
+        grid = self.grid()
+        array = np.ones(grid.array.shape)
+        grid.update_array(array)
+        self.assertTrue(np.all(grid.array == 1))
+        grid.update_slice(0, np.full(array.shape[:2], 2.0))
+        self.assertTrue(np.all(array == 1))
+        with self.assertRaises(ValueError):
+            grid.update_array(np.ones((2, 2, 2)))
+
+    def test_update_in_flight(self):
+        """The calculations in progress while the grid is updated end with
+        the values they started with"""
+        grid = self.grid()
+        shape = grid.array.shape
+        x, y = np.meshgrid(np.arange(-179.5, 179.0, 0.25),
+                           np.arange(-79.5, 79.0, 0.25),
+                           indexing="ij")
+        x = x.ravel()
+        y = y.ravel()
+        z = np.full(x.shape, 1.0)
+
+        def interpolate():
+            return core.trivariate_float64(grid,
+                                           x,
+                                           y,
+                                           z,
+                                           core.Bilinear3D(),
+                                           num_threads=1)
+
+        def smooth():
+            filtered = core.fill.loess_float64(
+                grid, value_type=core.fill.ValueType.All, num_threads=1)
+            return filtered[:, :, 1]
+
+        for calculation in [interpolate, smooth]:
+            results = []
+            done = threading.Event()
+
+            def worker():
+                try:
+                    for _ in range(4):
+                        results.append(calculation())
+                finally:
+                    done.set()
+
+            thread = threading.Thread(target=worker)
+            thread.start()
+            updates = 0
+            while not done.is_set():
+                updates += 1
+                grid.update_slice(1, np.full(shape[:2], float(updates)))
+            thread.join()
+
+            # Each result is computed from a single version of the slice.
+            self.assertEqual(len(results), 4)
+            for item in results:
+                self.assertLess(np.abs(item - item.flat[0]).max(), 1e-9)
+
+
+class TestMultiGrid3D(TestCase):
+    """Test of the C+++/Python interface of the pyinterp::MultiGrid3DFloat64
+    class"""
+    def test_multi_grid3d_interpolator(self):
+        """The interpolation of all variables at once must be identical to
+        the interpolation of each variable"""
+        grid = self.load_data()
+        multi_grid = core.MultiGrid3DFloat64(
+            grid.x, grid.y, grid.z,
+            np.stack([grid.array, grid.array * 2], axis=-1))
+        self.assertEqual(multi_grid.variables, 2)
+        other = pickle.loads(pickle.dumps(multi_grid))
+        self.assertEqual(multi_grid.z, other.z)
+
+        lon = np.arange(-180, 180, 1 / 3.0) + 1 / 3.0
+        lat = np.arange(-90, 90, 1 / 3.0) + 1 / 3.0
+        time = 898500 + 3
+        x, y, t = np.meshgrid(lon, lat, time, indexing="ij")
+        x = x.flatten()
+        y = y.flatten()
+        t = t.flatten()
+
+        for z_method in ["linear", "nearest"]:
+            z = core.trivariate_float64(multi_grid,
+                                        x,
+                                        y,
+                                        t,
+                                        core.Bilinear3D(),
+                                        z_method=z_method)
+            self.assertEqual(z.shape, (x.size, 2))
+            expected = core.trivariate_float64(grid,
+                                               x,
+                                               y,
+                                               t,
+                                               core.Bilinear3D(),
+                                               z_method=z_method)
+            self.assertTrue(np.allclose(z[:, 0], expected, equal_nan=True))
+            self.assertTrue(
+                np.allclose(z[:, 1], expected * 2, equal_nan=True))
+
+
 class Trivariate(TestCase):
     """Test of the C+++/Python interface of the trivariate interpolator"""
     def _test(self, interpolator, filename):
@@ -138,6 +285,72 @@ class Trivariate(TestCase):
             plot(x.reshape(shape), y.reshape(shape), z0.reshape(shape),
                  "tcw_bicubic.png")
 
+    def test_trivariate_bicubic_z_spline(self):
+        """A spline along the Z axis follows the curvature of the function"""
+        x_axis = core.Axis(np.arange(0.0, 40.0))
+        y_axis = core.Axis(np.arange(0.0, 40.0))
+        z_axis = core.Axis(np.arange(0.0, 20.0))
+        x, y, z = np.meshgrid(x_axis[:],
+                              y_axis[:],
+                              z_axis[:],
+                              indexing="ij")
+        grid = core.Grid3DFloat64(
+            x_axis, y_axis, z_axis,
+            np.sin(x * 0.1) * np.cos(y * 0.1) * np.sin(z * 0.3))
+
+        generator = np.random.RandomState(0)
+        x = generator.uniform(5, 34, 10000)
+        y = generator.uniform(5, 34, 10000)
+        z = generator.uniform(3, 16, 10000)
+        expected = np.sin(x * 0.1) * np.cos(y * 0.1) * np.sin(z * 0.3)
+
+        z0 = core.bicubic_float64(grid, x, y, z, num_threads=1)
+        z1 = core.bicubic_float64(grid, x, y, z, num_threads=1, nz=1)
+        self.assertTrue(np.all(z0 == z1))
+        z2 = core.bicubic_float64(grid, x, y, z, num_threads=1, nz=2)
+        self.assertLess(np.abs(z2 - expected).max(),
+                        np.abs(z0 - expected).max() / 4)
+
+        # The fitting models evaluated in closed form
+        z3 = core.bicubic_float64(
+            grid,
+            x,
+            y,
+            z,
+            fitting_model=core.FittingModel.CubicConvolution,
+            nz=2)
+        self.assertLess(np.abs(z3 - expected).max(), 1e-3)
+        coefficients = core.spline_coefficients_float64(grid)
+        self.assertIsInstance(coefficients, core.Grid3DFloat64)
+        z4 = core.bicubic_float64(coefficients,
+                                  x,
+                                  y,
+                                  z,
+                                  fitting_model=core.FittingModel.BSpline,
+                                  nz=2)
+        self.assertLess(np.abs(z4 - expected).max(), 1e-3)
+
+    def test_trivariate_spatial_sort(self):
+        """The points sorted on the grid give the same results"""
+        grid = self.load_data()
+        generator = np.random.RandomState(0)
+        x = generator.uniform(-180, 180, 100000)
+        y = generator.uniform(-80, 80, 100000)
+        t = generator.uniform(898500, 898524, 100000)
+
+        z0 = core.trivariate_float64(grid, x, y, t, core.Bilinear3D())
+        z1 = core.trivariate_float64(grid,
+                                     x,
+                                     y,
+                                     t,
+                                     core.Bilinear3D(),
+                                     spatial_sort=True)
+        self.assertTrue(np.all(np.ma.fix_invalid(z0) == np.ma.fix_invalid(z1)))
+
+        z0 = core.bicubic_float64(grid, x, y, t)
+        z1 = core.bicubic_float64(grid, x, y, t, spatial_sort=True)
+        self.assertTrue(np.all(np.ma.fix_invalid(z0) == np.ma.fix_invalid(z1)))
+
     def test_grid3d_bounds_error(self):
         """Test of the detection on interpolation outside bounds"""
         grid = self.load_data()
@@ -208,6 +421,45 @@ class Trivariate(TestCase):
                                     z_method="NEAREST",
                                     num_threads=0)
 
+    def test_grid3d_z_nearest(self):
+        """The nearest method interpolates the nearest plane of the Z-axis"""
+        generator = np.random.RandomState(0)
+        x_axis = core.Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+        y_axis = core.Axis(np.arange(-80.0, 81.0, 1.0))
+        array = generator.uniform(-1, 1, (360, 161, 10))
+        x = generator.uniform(-180, 180, 10000)
+        y = generator.uniform(-80, 80, 10000)
+        z = generator.uniform(0, 9, 10000)
+
+        for temporal_axis in [False, True]:
+            if temporal_axis:
+                grid = core.TemporalGrid3DFloat64(
+                    x_axis, y_axis,
+                    core.TemporalAxis(np.arange(10, dtype="int64") * 3600),
+                    array)
+                z_values = (z * 3600).astype("int64")
+                step = 3600
+                interpolator = core.TemporalBilinear3D()
+            else:
+                grid = core.Grid3DFloat64(x_axis, y_axis,
+                                          core.Axis(np.arange(10.0)), array)
+                z_values = z
+                step = 1
+                interpolator = core.Bilinear3D()
+            # Nearest grid point, the upper one in case of a tie
+            z0 = z_values // step * step
+            z_nearest = np.where(z_values - z0 < z0 + step - z_values, z0,
+                                 z0 + step).astype(z_values.dtype)
+            calculated = core.trivariate_float64(grid,
+                                                 x,
+                                                 y,
+                                                 z_values,
+                                                 interpolator,
+                                                 z_method="nearest")
+            expected = core.trivariate_float64(grid, x, y, z_nearest,
+                                               interpolator)
+            self.assertTrue(np.allclose(calculated, expected))
+
     def test_grid3d_interpolator(self):
         """Testing of different interpolation methods"""
         a = self._test(core.Nearest3D(), "tcw_trivariate_nearest")
@@ -217,6 +469,34 @@ class Trivariate(TestCase):
         self.assertTrue((a - c).std() != 0)
         self.assertTrue((b - c).std() != 0)
 
+    def test_grid3d_circle(self):
+        """Bilinear interpolation in the cell connecting the last and the
+        first longitudes"""
+        lon = np.arange(0, 360, 10.0)
+        lat = np.arange(-80, 81, 10.0)
+        time = np.arange(3.0)
+        mx, my, mz = np.meshgrid(lon, lat, time, indexing="ij")
+        array = np.sin(np.radians(mx)) + my / 100 + mz
+        x_axis = core.Axis(lon, is_circle=True)
+        grid = core.Grid3DFloat64(x_axis, core.Axis(lat), core.Axis(time),
+                                  array)
+        multi_grid = core.MultiGrid3DFloat64(
+            x_axis, core.Axis(lat), core.Axis(time),
+            np.stack([array, array * 2], axis=-1))
+        x = np.array([351, 355, 359.5, -5, -0.5])
+        y = np.full_like(x, 5)
+        z = np.full_like(x, 0.5)
+        t = (x % 360 - 350) / 10
+        expected = (1 - t) * np.sin(np.radians(350)) + y / 100 + z
+        self.assertTrue(
+            np.allclose(
+                core.trivariate_float64(grid, x, y, z, core.Bilinear3D()),
+                expected))
+        values = core.trivariate_float64(multi_grid, x, y, z,
+                                         core.Bilinear3D())
+        self.assertTrue(np.allclose(values[:, 0], expected))
+        self.assertTrue(np.allclose(values[:, 1], expected * 2))
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -52,6 +52,7 @@ class Fill(unittest.TestCase):
         filled1[np.isnan(filled1)] = 0
         filled2[np.isnan(filled2)] = 0
         self.assertEqual((filled0 - filled1).mean(), 0)
+        self.assertTrue(np.all(filled0 == filled1))
         self.assertEqual(np.ma.fix_invalid(grid.array - filled1).mean(), 0)
         self.assertNotEqual((data - filled1).mean(), 0)
         self.assertNotEqual((filled2 - filled1).mean(), 0)
@@ -59,6 +60,33 @@ class Fill(unittest.TestCase):
         with self.assertRaises(ValueError):
             pyinterp.fill.gauss_seidel(grid, '_')
 
+        # Both sweeps solve the same equation
+        _, filled0 = pyinterp.fill.gauss_seidel(grid,
+                                                epsilon=1e-8,
+                                                num_threads=0)
+        _, filled1 = pyinterp.fill.gauss_seidel(grid,
+                                                epsilon=1e-8,
+                                                num_threads=0,
+                                                sweep="pipelined")
+        self.assertLess(np.nanmax(np.abs(filled0 - filled1)), 1e-4)
+
+        with self.assertRaises(ValueError):
+            pyinterp.fill.gauss_seidel(grid, sweep='_')
+
+        # The number of threads is still the argument following the
+        # relaxation constant, and both solvers spell it the same way.
+        first_guess = pyinterp.core.fill.FirstGuess.ZonalAverage
+        for function in [
+                lambda data: pyinterp.core.fill.gauss_seidel_float64(
+                    data, first_guess, True, 10, 1e-4, 1.0, 1),
+                lambda data: pyinterp.core.fill.gauss_seidel_float64(
+                    data, num_thread=1),
+                lambda data: pyinterp.core.fill.multigrid_float64(
+                    data, num_thread=1)
+        ]:
+            iterations, _ = function(np.copy(grid.array))
+            self.assertGreater(iterations, 0)
+
         x_axis = pyinterp.Axis(np.linspace(-180, 180, 10), is_circle=True)
         y_axis = pyinterp.Axis(np.linspace(-90, 90, 10), is_circle=False)
         data = np.random.rand(len(x_axis), len(y_axis))
@@ -66,6 +94,32 @@ class Fill(unittest.TestCase):
         _, filled0 = pyinterp.fill.gauss_seidel(grid, num_threads=0)
         self.assertIsInstance(filled0, np.ndarray)
 
+    def test_multigrid(self):
+        grid = self._load()
+        mask = np.isnan(grid.array)
+        converged0, filled0 = pyinterp.fill.multigrid(grid, num_threads=0)
+        converged1, filled1 = pyinterp.fill.multigrid(grid, num_threads=1)
+        self.assertTrue(converged0)
+        self.assertTrue(converged1)
+        self.assertFalse(np.isnan(filled0).any())
+        self.assertTrue(np.all(filled0 == filled1))
+        self.assertTrue(np.all(filled0[~mask] == grid.array[~mask]))
+
+        # Both methods solve the same equation
+        _, reference = pyinterp.fill.gauss_seidel(grid,
+                                                  epsilon=1e-8,
+                                                  num_threads=1)
+        _, filled = pyinterp.fill.multigrid(grid, epsilon=1e-8)
+        self.assertLess(np.abs(filled - reference).max(), 1e-4)
+
+        with self.assertRaises(ValueError):
+            pyinterp.fill.multigrid(grid, '_')
+
+    def test_multigrid_3d(self):
+        grid = self._load(True)
+        _, filled0 = pyinterp.fill.multigrid(grid, num_threads=0)
+        self.assertTrue(np.all(filled0[:, :, 0] == filled0[:, :, 1]))
+
     def test_loess_3d(self):
         grid = self._load(True)
         mask = np.isnan(grid.array)
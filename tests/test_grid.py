@@ -2,6 +2,7 @@
 #
 # All rights reserved. Use of this source code is governed by a
 # BSD-style license that can be found in the LICENSE file.
+import pickle
 import unittest
 import numpy as np
 import pyinterp
@@ -66,6 +67,77 @@ class Grid2D(unittest.TestCase):
         with self.assertRaises(ValueError):
             pyinterp.grid._core_variate_interpolator(grid, '_')
 
+    def test_spline_coefficients(self):
+        lon = pyinterp.Axis(np.arange(0, 360, 1), is_circle=True)
+        lat = pyinterp.Axis(np.arange(-80, 80, 1), is_circle=False)
+        mx, my = np.meshgrid(lon[:], lat[:], indexing="ij")
+
+        def function(x, y):
+            return np.cos(np.radians(x)) * np.sin(np.radians(2 * y))
+
+        grid = pyinterp.Grid2D(lon, lat, function(mx, my))
+
+        # The coefficients are computed once, and pickled with the grid
+        coefficients = grid.spline_coefficients()
+        self.assertIsInstance(coefficients, pyinterp.core.Grid2DFloat64)
+        self.assertIs(grid.spline_coefficients(), coefficients)
+        other = pickle.loads(pickle.dumps(grid))
+        self.assertTrue(
+            np.all(other.spline_coefficients().array == coefficients.array))
+
+        x = np.array([10.5, 200.25])
+        y = np.array([-30.5, 40.75])
+        z = pyinterp.bicubic(grid, x, y, fitting_model="b_spline")
+        self.assertTrue(np.allclose(z, function(x, y), atol=1e-6))
+
+        # First and last columns: the X axis is periodic, whatever the
+        # boundary.
+        x, y = np.meshgrid([0, 0.5, 359, 359.5, -0.25], [-30.5, 40.75])
+        x = x.ravel()
+        y = y.ravel()
+        for boundary in ["sym", "wrap"]:
+            z = pyinterp.bicubic(grid,
+                                 x,
+                                 y,
+                                 fitting_model="b_spline",
+                                 boundary=boundary)
+            self.assertTrue(np.allclose(z, function(x, y), atol=1e-6))
+
+        # First and last rows, with the default "sym" boundary: the nodes
+        # are interpolated exactly, and the values between them differ from
+        # the function by the effect of the mirror (5e-3 at most here).
+        x, y = np.meshgrid([0, 10.5, 200.25, 359.5], [-80, -79, 78, 79])
+        x = x.ravel()
+        y = y.ravel()
+        z = pyinterp.bicubic(grid, x, y, fitting_model="b_spline")
+        self.assertTrue(np.allclose(z, function(x, y), atol=1e-6))
+        x, y = np.meshgrid([0, 10.5, 200.25, 359.5],
+                           [-79.75, -79.5, 78.5, 78.75])
+        x = x.ravel()
+        y = y.ravel()
+        z = pyinterp.bicubic(grid, x, y, fitting_model="b_spline")
+        self.assertTrue(np.allclose(z, function(x, y), atol=6e-3))
+
+        # The points of the last cell of the Y axis are undefined without
+        # boundary
+        x = np.array([10.5, 200.25])
+        y = np.array([78.5, 78.75])
+        z = pyinterp.bicubic(grid,
+                             x,
+                             y,
+                             fitting_model="b_spline",
+                             boundary="undef")
+        self.assertTrue(np.all(np.isnan(z)))
+
+        # The coefficients are computed again if the values are replaced
+        time = np.arange(2.0)
+        grid = pyinterp.Grid3D(lon, lat, pyinterp.Axis(time),
+                               np.zeros((len(lon), len(lat), len(time))))
+        self.assertTrue(np.all(grid.spline_coefficients().array == 0))
+        grid.update_slice(1, np.ones((len(lon), len(lat))))
+        self.assertTrue(np.allclose(grid.spline_coefficients().array[:, :, 1],
+                                    1))
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -121,6 +121,45 @@ class Grid2D(unittest.TestCase):
                  method="bilinear")
         self.assertIsInstance(z, np.ndarray)
 
+    def test_dtype(self):
+        """The values are returned in single precision on request"""
+        grid = pyinterp.backends.xarray.Grid2D(
+            xr.load_dataset(self.GRID).mss.astype("float32"))
+        lon = np.arange(-180, 180, 1) + 1 / 3.0
+        lat = np.arange(-80, 80, 1) + 1 / 3.0
+        x, y = np.meshgrid(lon, lat, indexing="ij")
+        x, y = x.ravel(), y.ravel()
+
+        expected = pyinterp.bivariate(grid, x, y)
+        self.assertEqual(expected.dtype, np.float64)
+        z = pyinterp.bivariate(grid, x, y, dtype=np.float32)
+        self.assertEqual(z.dtype, np.float32)
+        self.assertTrue(
+            np.allclose(z, expected, rtol=1e-5, atol=1e-3, equal_nan=True))
+
+        # The bicubic interpolation is calculated in double precision
+        for fitting_model in ["c_spline", "b_spline"]:
+            expected = pyinterp.bicubic(grid,
+                                        x,
+                                        y,
+                                        fitting_model=fitting_model)
+            z = pyinterp.bicubic(grid,
+                                 x,
+                                 y,
+                                 fitting_model=fitting_model,
+                                 dtype="float32")
+            self.assertEqual(z.dtype, np.float32)
+            self.assertTrue(
+                np.all((z == expected.astype("float32"))
+                       | np.isnan(expected)))
+
+        with self.assertRaises(ValueError):
+            pyinterp.bivariate(grid, x, y, dtype=np.int32)
+
+        grid = pyinterp.backends.xarray.Grid2D(xr.load_dataset(self.GRID).mss)
+        with self.assertRaises(ValueError):
+            pyinterp.bivariate(grid, x, y, dtype=np.float32)
+
     def test_bicubic(self):
         grid = pyinterp.backends.xarray.Grid2D(xr.load_dataset(self.GRID).mss)
 
@@ -253,6 +292,94 @@ class Trivariate(unittest.TestCase):
         self.assertIsInstance(z, np.ndarray)
 
 
+class TrivariateStream(unittest.TestCase):
+    @staticmethod
+    def series(dates):
+        x_axis = pyinterp.Axis(np.arange(-180.0, 180.0, 2.0), is_circle=True)
+        y_axis = pyinterp.Axis(np.arange(-90.0, 90.5, 2.0))
+        values = np.random.RandomState(0).uniform(
+            size=(len(x_axis), len(y_axis), len(dates)))
+        if np.issubdtype(dates.dtype, np.dtype("datetime64")):
+            z_axis = pyinterp.TemporalAxis(dates)
+        else:
+            z_axis = pyinterp.Axis(dates)
+        return pyinterp.Grid3D(x_axis, y_axis, z_axis, values)
+
+    def check(self, dates, points):
+        grid = self.series(dates)
+        generator = np.random.RandomState(1)
+        x = generator.uniform(-180, 180, points.size)
+        y = generator.uniform(-90, 90, points.size)
+        z = points
+        if np.issubdtype(points.dtype, np.dtype("datetime64")):
+            z = points.astype("int64")
+        expected = pyinterp.trivariate(grid, x, y, z, num_threads=1)
+
+        read = []
+
+        def fields():
+            for ix, date in enumerate(dates):
+                read.append(ix)
+                yield date, grid.array[:, :, ix]
+
+        stream = pyinterp.TrivariateStream(grid.x,
+                                           grid.y,
+                                           fields(),
+                                           num_threads=1)
+        values = np.concatenate([
+            stream(x[item], y[item], points[item])
+            for item in np.array_split(np.arange(points.size), 7)
+        ])
+        self.assertTrue(
+            np.allclose(values, expected, rtol=0, atol=1e-12,
+                        equal_nan=True))
+        self.assertEqual(len(read), len(dates))
+
+        # The fields already released cannot be interpolated again
+        with self.assertRaises(ValueError):
+            stream(x[:1], y[:1], points[points.size // 2:][:1])
+
+    def test_numeric(self):
+        dates = np.arange(24.0)
+        points = np.sort(
+            np.random.RandomState(2).uniform(-1, 25, 10000))
+        points[1000:2000] = 7.25
+        self.check(dates, points)
+
+    def test_datetime64(self):
+        dates = np.arange(np.datetime64("2000-01-01T00:00:00"),
+                          np.datetime64("2000-01-02T00:00:00"),
+                          np.timedelta64(1, "h"))
+        points = dates[0] + np.sort(
+            np.random.RandomState(2).randint(-3600, 86400 + 3600,
+                                             10000)).astype("timedelta64[s]")
+        self.check(dates, points)
+
+    def test_errors(self):
+        dates = np.arange(4.0)
+        grid = self.series(dates)
+        fields = [(date, grid.array[:, :, ix])
+                  for ix, date in enumerate(dates)]
+        stream = pyinterp.TrivariateStream(grid.x, grid.y, iter(fields))
+        with self.assertRaises(ValueError):
+            stream(np.zeros(2), np.zeros(2), np.array([1.0, 0.5]))
+        with self.assertRaises(TypeError):
+            stream(np.zeros(1), np.zeros(1),
+                   np.array(["2000-01-01"], dtype="datetime64[s]"))
+
+        stream = pyinterp.TrivariateStream(grid.x,
+                                           grid.y,
+                                           iter(fields),
+                                           bounds_error=True)
+        with self.assertRaises(ValueError):
+            stream(np.zeros(1), np.zeros(1), np.array([4.5]))
+
+        stream = pyinterp.TrivariateStream(grid.x, grid.y,
+                                           iter(fields[::-1]))
+        with self.assertRaises(ValueError):
+            stream(np.zeros(1), np.zeros(1), np.array([1.0]))
+
+
 class Quadrivariate(unittest.TestCase):
     GRID = os.path.join(os.path.dirname(os.path.abspath(__file__)), "dataset",
                         "pres_temp_4D.nc")
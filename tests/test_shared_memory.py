@@ -0,0 +1,87 @@
+# Copyright (c) 2020 CNES
+#
+# All rights reserved. Use of this source code is governed by a
+# BSD-style license that can be found in the LICENSE file.
+import multiprocessing
+import os
+import unittest
+import numpy as np
+import pyinterp
+import pyinterp.core
+import pyinterp.shared_memory
+
+
+def _interpolate(name):
+    """Interpolates the grid published by the parent process"""
+    grid = pyinterp.shared_memory.attach(name)
+    return pyinterp.bivariate(grid, np.array([0.5]), np.array([0.5]))[0]
+
+
+class SharedMemory(unittest.TestCase):
+    NAME = "/pyinterp_test_%d" % os.getpid()
+
+    def setUp(self):
+        pyinterp.core.SharedMemory.unlink(self.NAME)
+
+    @staticmethod
+    def grid():
+        x_axis = pyinterp.Axis(np.arange(-180.0, 180.0, 1.0), is_circle=True)
+        y_axis = pyinterp.Axis(np.arange(-80.0, 80.0, 1.0))
+        array, _ = np.meshgrid(x_axis[:], y_axis[:], indexing="ij")
+        return pyinterp.Grid2D(x_axis, y_axis, array)
+
+    def test_segment(self):
+        segment = pyinterp.core.SharedMemory.create(self.NAME, 128)
+        self.assertEqual(segment.name, self.NAME)
+        self.assertEqual(segment.size, 128)
+        self.assertEqual(segment.ref_count, 1)
+        with self.assertRaises(RuntimeError):
+            pyinterp.core.SharedMemory.create(self.NAME, 128)
+        other = pyinterp.core.SharedMemory.attach(self.NAME)
+        self.assertEqual(segment.ref_count, 2)
+        memoryview(segment)[0] = 42
+        self.assertEqual(memoryview(other)[0], 42)
+        del other
+        self.assertEqual(segment.ref_count, 1)
+        del segment
+        with self.assertRaises(RuntimeError):
+            pyinterp.core.SharedMemory.attach(self.NAME)
+
+    def test_publish(self):
+        grid = self.grid()
+        segment = pyinterp.shared_memory.publish(grid, self.NAME)
+        other = pyinterp.shared_memory.attach(self.NAME)
+        self.assertIsInstance(other, pyinterp.Grid2D)
+        self.assertEqual(segment.ref_count, 2)
+        self.assertEqual(other.x, grid.x)
+        self.assertEqual(other.y, grid.y)
+        self.assertTrue(np.all(other.array == grid.array))
+        self.assertFalse(other.array.flags.writeable)
+
+        another = pyinterp.shared_memory.attach(self.NAME)
+        self.assertEqual(segment.ref_count, 3)
+        del another
+        self.assertEqual(segment.ref_count, 2)
+
+        with multiprocessing.Pool(2) as pool:
+            values = pool.map(_interpolate, [self.NAME] * 4)
+        self.assertTrue(np.allclose(values, 0.5))
+
+        del segment
+        # The grid attached keeps the segment alive
+        self.assertTrue(np.all(other.array == grid.array))
+        del other
+        with self.assertRaises(RuntimeError):
+            pyinterp.core.SharedMemory.attach(self.NAME)
+
+    def test_publish_core_grid(self):
+        grid = self.grid()._instance
+        segment = pyinterp.shared_memory.publish(grid, self.NAME)
+        other = pyinterp.shared_memory.attach(self.NAME)
+        self.assertIsInstance(other, pyinterp.core.Grid2DFloat64)
+        self.assertTrue(np.all(other.array == grid.array))
+        del segment
+
+
+if __name__ == "__main__":
+    unittest.main()